@@ -35,6 +35,7 @@
 #include <variant>
 #include <any>
 #include <vector>
+#include <ranges>
 #include <map>
 #include <algorithm>
 #include <charconv>
@@ -44,12 +45,32 @@
 #include <stdio.h>
 #include <functional>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_set>
+#include <limits>
+#include <cmath>
+#include <stdexcept>
+#include <tuple>
+
+#if !defined(JSON_DISABLE_SIMD) and (defined(__SSE2__) or defined(_M_X64) or (defined(_M_IX86_FP) and _M_IX86_FP >= 2))
+#include <immintrin.h>
+#define JSON_SSE2 1
+#if defined(__SSSE3__) or defined(__AVX__)
+#define JSON_SSSE3 1
+#endif // __SSSE3__
+#if defined(__AVX2__)
+#define JSON_AVX2 1
+#endif // __AVX2__
+#endif // JSON_DISABLE_SIMD
 
 namespace json {
 
     enum struct parse_error_t : uint8_t {
         error,
         happy_ending,
+        skip,
         unknown_string_character,
         unknown_space,
         unknown_ESC,
@@ -68,7 +89,8 @@ namespace json {
 
     enum struct serialize_error_t : uint8_t {
         error,
-        unknown_utf8_bytes
+        unknown_utf8_bytes,
+        non_finite_number
     };
 
     constexpr const char* error_string(const parse_error_t err)noexcept {
@@ -77,6 +99,8 @@ namespace json {
                 return "Error.";
             case parse_error_t::happy_ending:
                 return "Happy ending.";
+            case parse_error_t::skip:
+                return "Skip.";
             case parse_error_t::unknown_string_character:
                 return "Unknown string character.";
             case parse_error_t::unknown_space:
@@ -115,6 +139,8 @@ namespace json {
                 return "Error.";
             case serialize_error_t::unknown_utf8_bytes:
                 return "Unknown utf8 bytes.";
+            case serialize_error_t::non_finite_number:
+                return "Non-finite number.";
             default:
                 std::unreachable();
         }
@@ -122,54 +148,1514 @@ namespace json {
     }
 
     template<class P>
-    concept Parser = requires(P p, char c, const char* data, size_t size) {
+    concept Parser = requires(P p, char c, const char* data, size_t size, double x, std::string_view str) {
         { p.on_null() }->std::same_as<std::optional<parse_error_t>>;
         { p.on_true() }->std::same_as<std::optional<parse_error_t>>;
         { p.on_false() }->std::same_as<std::optional<parse_error_t>>;
         { p.on_string(data, size) }->std::same_as<std::optional<parse_error_t>>;
         { p.on_string_begin() }->std::same_as<std::optional<parse_error_t>>;
         { p.on_string_end() }->std::same_as<std::optional<parse_error_t>>;
+        { p.on_string_end(str) }->std::same_as<std::optional<parse_error_t>>;
         { p.on_comma() }->std::same_as<std::optional<parse_error_t>>;
+        { p.on_skipped() }->std::same_as<std::optional<parse_error_t>>;
         { p.on_colon() }->std::same_as<std::optional<parse_error_t>>;
-        { p.on_number(c) }->std::same_as<std::optional<parse_error_t>>;
-        { p.on_number_begin(c) }->std::same_as<std::optional<parse_error_t>>;
-        { p.on_number_end() }->std::same_as<std::optional<parse_error_t>>;
+        { p.on_number(x) }->std::same_as<std::optional<parse_error_t>>;
+        { p.on_number_begin() }->std::same_as<std::optional<parse_error_t>>;
         { p.on_left_square_bracket() }->std::same_as<std::optional<parse_error_t>>;
         { p.on_right_square_bracket() }->std::same_as<std::optional<parse_error_t>>;
         { p.on_left_brace() }->std::same_as<std::optional<parse_error_t>>;
         { p.on_right_brace() }->std::same_as<std::optional<parse_error_t>>;
     };
 
+    // Strings are passed as views of a buffer that is reused right after the call, copy what you keep.
+    // Returning parse_error_t::skip from on_key, on_object_begin or on_array_begin drops that value: the
+    // parser jumps over it counting brackets and quotes only, without events and without validating it.
     template<class B>
-    concept Builder = requires(B b, std::string str, std::string num, bool bb) {
+    concept Builder = requires(B b, std::string_view str, double num, bool bb) {
         { b.on_document_begin() }->std::same_as<std::optional<parse_error_t>>;
         { b.on_document_end() }->std::same_as<std::optional<parse_error_t>>;
         { b.on_object_begin() }->std::same_as<std::optional<parse_error_t>>;
         { b.on_object_end() }->std::same_as<std::optional<parse_error_t>>;
         { b.on_array_begin() }->std::same_as<std::optional<parse_error_t>>;
         { b.on_array_end() }->std::same_as<std::optional<parse_error_t>>;
-        { b.on_key(std::move(str)) }->std::same_as<std::optional<parse_error_t>>;
-        { b.on_string(std::move(str)) }->std::same_as<std::optional<parse_error_t>>;
-        { b.on_number(std::move(num)) }->std::same_as<std::optional<parse_error_t>>;
+        { b.on_key(str) }->std::same_as<std::optional<parse_error_t>>;
+        { b.on_string(str) }->std::same_as<std::optional<parse_error_t>>;
+        { b.on_number(num) }->std::same_as<std::optional<parse_error_t>>;
         { b.on_bool(bb) }->std::same_as<std::optional<parse_error_t>>;
         { b.on_null() }->std::same_as<std::optional<parse_error_t>>;
         { b.get() };
     };
 
+    // A Builder that may keep views of the input: escape free strings of a complete buffer are passed to
+    // on_borrowed_key / on_borrowed_string, pointing straight into it and valid as long as the input is.
+    template<class B>
+    concept BorrowingBuilder = Builder<B> and requires(B b, std::string_view str) {
+        { b.on_borrowed_key(str) }->std::same_as<std::optional<parse_error_t>>;
+        { b.on_borrowed_string(str) }->std::same_as<std::optional<parse_error_t>>;
+    };
+
     namespace detail {
+        namespace simd {
+#if defined(JSON_AVX2)
+            inline uint32_t space_mask(const char* p)noexcept {
+                const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+                const __m256i s = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n'))),
+                    _mm256_or_si256(
+                        _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r'))),
+                        _mm256_cmpeq_epi8(v, _mm256_setzero_si256())));
+                return static_cast<uint32_t>(_mm256_movemask_epi8(s));
+            }
+#endif // JSON_AVX2
+
+#if defined(JSON_SSE2)
+            inline uint32_t space_mask_16(const char* p)noexcept {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+                const __m128i s = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\n'))),
+                    _mm_or_si128(
+                        _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\t')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\r'))),
+                        _mm_cmpeq_epi8(v, _mm_setzero_si128())));
+                return static_cast<uint32_t>(_mm_movemask_epi8(s));
+            }
+#endif // JSON_SSE2
+
+            // Skips a run of ' ', '\n', '\t', '\r', '\0' in whole blocks, returns the first non space
+            // character or the last position from which less than one block is left.
+            inline const char* skip_space(const char* iter, const char* const end)noexcept {
+#if defined(JSON_AVX2)
+                while (end - iter >= 32) {
+                    const uint32_t m = ~space_mask(iter);
+                    if (m)
+                        return iter + std::countr_zero(m);
+                    iter += 32;
+                }
+#endif // JSON_AVX2
+#if defined(JSON_SSE2)
+                while (end - iter >= 16) {
+                    const uint32_t m = ~space_mask_16(iter) & 0xFFFF;
+                    if (m)
+                        return iter + std::countr_zero(m);
+                    iter += 16;
+                }
+#endif // JSON_SSE2
+                return iter;
+            }
+
+            // Returns the first non digit in [iter, end), eight bytes are tested at a time.
+            inline const char* skip_digits(const char* iter, const char* const end)noexcept {
+                while (end - iter >= 8) {
+                    uint64_t v;
+                    std::memcpy(&v, iter, 8);
+                    if constexpr (std::endian::native == std::endian::big)
+                        v = std::byteswap(v);
+                    // a byte is a digit iff its high nibble is 3 and adding 6 keeps it there, a carry only
+                    // reaches bytes after the first bad one
+                    const uint64_t bad = ((v & 0xF0F0F0F0F0F0F0F0) ^ 0x3030303030303030)
+                        | (((v + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) ^ 0x3030303030303030);
+                    if (bad)
+                        return iter + (std::countr_zero(bad) >> 3);
+                    iter += 8;
+                }
+                while (iter != end and *iter >= '0' and *iter <= '9') {
+                    ++iter;
+                }
+                return iter;
+            }
+
+            constexpr bool is_plain_string_byte(const uint8_t c)noexcept {
+                return c >= 0x20 and c < 0x7F and c != '\"' and c != '\\';
+            }
+
+#if defined(JSON_AVX2)
+            inline uint32_t special_string_mask(const char* p)noexcept {
+                const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+                // signed compare: catches 0x00-0x1F as well as every byte >= 0x80
+                const __m256i s = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(0x20), v), _mm256_cmpeq_epi8(v, _mm256_set1_epi8(0x7F))),
+                    _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\"')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\'))));
+                return static_cast<uint32_t>(_mm256_movemask_epi8(s));
+            }
+#endif // JSON_AVX2
+
+#if defined(JSON_SSE2)
+            inline uint32_t special_string_mask_16(const char* p)noexcept {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+                const __m128i s = _mm_or_si128(
+                    _mm_or_si128(_mm_cmplt_epi8(v, _mm_set1_epi8(0x20)), _mm_cmpeq_epi8(v, _mm_set1_epi8(0x7F))),
+                    _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\"')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\\'))));
+                return static_cast<uint32_t>(_mm_movemask_epi8(s));
+            }
+#endif // JSON_SSE2
+
+            // Returns the first '\"', '\\', control character or non ASCII byte in [iter, end), or end.
+            inline const char* scan_string(const char* iter, const char* const end)noexcept {
+#if defined(JSON_AVX2)
+                while (end - iter >= 32) {
+                    const uint32_t m = special_string_mask(iter);
+                    if (m)
+                        return iter + std::countr_zero(m);
+                    iter += 32;
+                }
+#endif // JSON_AVX2
+#if defined(JSON_SSE2)
+                while (end - iter >= 16) {
+                    const uint32_t m = special_string_mask_16(iter);
+                    if (m)
+                        return iter + std::countr_zero(m);
+                    iter += 16;
+                }
+#endif // JSON_SSE2
+                while (iter != end and is_plain_string_byte(static_cast<uint8_t>(*iter))) {
+                    ++iter;
+                }
+                return iter;
+            }
+
+            // Start of a multibyte sequence cut by p, or p itself when every sequence before it is complete.
+            inline const char* utf8_boundary(const char* const first, const char* const p)noexcept {
+                for (int i = 1; i <= 3 and p - i >= first; ++i) {
+                    const auto c = static_cast<uint8_t>(p[-i]);
+                    if (c >= 0xC0)
+                        return (c >= 0xF0 ? 4 : c >= 0xE0 ? 3 : 2) > i ? p - i : p;
+                    if (c < 0x80)
+                        break;
+                }
+                return p;
+            }
+
+#if defined(JSON_SSSE3)
+            // Keiser & Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte": every error is
+            // recognised from the high and low nibble of a byte and the high nibble of the byte after it,
+            // plus a check that the 2nd and 3rd byte after a 3/4-byte lead are continuations.
+            namespace utf8 {
+                constexpr uint8_t too_short = 1 << 0;   // 11______ 0_______ , 11______ 11______
+                constexpr uint8_t too_long = 1 << 1;    // 0_______ 10______
+                constexpr uint8_t overlong_3 = 1 << 2;  // 11100000 100_____
+                constexpr uint8_t too_large = 1 << 3;   // 11110100 1001____ , 11110100 101_____ , 11110101+
+                constexpr uint8_t surrogate = 1 << 4;   // 11101101 101_____
+                constexpr uint8_t overlong_2 = 1 << 5;  // 1100000_ 10______
+                constexpr uint8_t too_large_1000 = 1 << 6;  // 11110101+ 1000____
+                constexpr uint8_t overlong_4 = 1 << 6;  // 11110000 1000____
+                constexpr uint8_t two_conts = 1 << 7;   // 10______ 10______
+                constexpr uint8_t carry = too_short | too_long | two_conts;
+
+                constexpr uint8_t byte_1_high[16] = {
+                    too_long, too_long, too_long, too_long, too_long, too_long, too_long, too_long,
+                    two_conts, two_conts, two_conts, two_conts,
+                    too_short | overlong_2,
+                    too_short,
+                    too_short | overlong_3 | surrogate,
+                    too_short | too_large | too_large_1000 | overlong_4
+                };
+                constexpr uint8_t byte_1_low[16] = {
+                    carry | overlong_3 | overlong_2 | overlong_4,
+                    carry | overlong_2,
+                    carry,
+                    carry,
+                    carry | too_large,
+                    carry | too_large | too_large_1000,
+                    carry | too_large | too_large_1000,
+                    carry | too_large | too_large_1000,
+                    carry | too_large | too_large_1000,
+                    carry | too_large | too_large_1000,
+                    carry | too_large | too_large_1000,
+                    carry | too_large | too_large_1000,
+                    carry | too_large | too_large_1000,
+                    carry | too_large | too_large_1000 | surrogate,
+                    carry | too_large | too_large_1000,
+                    carry | too_large | too_large_1000
+                };
+                constexpr uint8_t byte_2_high[16] = {
+                    too_short, too_short, too_short, too_short, too_short, too_short, too_short, too_short,
+                    too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,
+                    too_long | overlong_2 | two_conts | overlong_3 | too_large,
+                    too_long | overlong_2 | two_conts | surrogate | too_large,
+                    too_long | overlong_2 | two_conts | surrogate | too_large,
+                    too_short, too_short, too_short, too_short
+                };
+
+                // bytes at index >= n are replaced by this
+                alignas(64) constexpr int8_t tail_mask[64] = {
+                    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+                };
+            }
+
+            inline __m128i utf8_errors_16(const __m128i input, const __m128i prev_input)noexcept {
+                const __m128i low_nibble = _mm_set1_epi8(0x0F);
+                const __m128i prev1 = _mm_alignr_epi8(input, prev_input, 15);
+                const __m128i b1_high = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(utf8::byte_1_high)),
+                    _mm_and_si128(_mm_srli_epi16(prev1, 4), low_nibble));
+                const __m128i b1_low = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(utf8::byte_1_low)),
+                    _mm_and_si128(prev1, low_nibble));
+                const __m128i b2_high = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(utf8::byte_2_high)),
+                    _mm_and_si128(_mm_srli_epi16(input, 4), low_nibble));
+                const __m128i special = _mm_and_si128(_mm_and_si128(b1_high, b1_low), b2_high);
+
+                const __m128i prev2 = _mm_alignr_epi8(input, prev_input, 14);
+                const __m128i prev3 = _mm_alignr_epi8(input, prev_input, 13);
+                const __m128i third = _mm_subs_epu8(prev2, _mm_set1_epi8(char(0xE0 - 0x80)));
+                const __m128i fourth = _mm_subs_epu8(prev3, _mm_set1_epi8(char(0xF0 - 0x80)));
+                const __m128i must23 = _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8(char(0x80)));
+                return _mm_xor_si128(must23, special);
+            }
+
+            inline uint32_t ascii_special_mask_16(const __m128i v)noexcept {
+                const __m128i ctrl = _mm_cmpeq_epi8(_mm_min_epu8(v, _mm_set1_epi8(0x1F)), v);
+                return static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(
+                    _mm_or_si128(ctrl, _mm_cmpeq_epi8(v, _mm_set1_epi8(0x7F))),
+                    _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\"')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\\'))))));
+            }
+#endif // JSON_SSSE3
+
+#if defined(JSON_AVX2)
+            inline __m256i utf8_errors(const __m256i input, const __m256i prev_input)noexcept {
+                const __m256i low_nibble = _mm256_set1_epi8(0x0F);
+                const __m256i shifted = _mm256_permute2x128_si256(prev_input, input, 0x21);
+                const __m256i prev1 = _mm256_alignr_epi8(input, shifted, 15);
+                const __m256i b1_high = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(utf8::byte_1_high))),
+                    _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_nibble));
+                const __m256i b1_low = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(utf8::byte_1_low))),
+                    _mm256_and_si256(prev1, low_nibble));
+                const __m256i b2_high = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(utf8::byte_2_high))),
+                    _mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibble));
+                const __m256i special = _mm256_and_si256(_mm256_and_si256(b1_high, b1_low), b2_high);
+
+                const __m256i prev2 = _mm256_alignr_epi8(input, shifted, 14);
+                const __m256i prev3 = _mm256_alignr_epi8(input, shifted, 13);
+                const __m256i third = _mm256_subs_epu8(prev2, _mm256_set1_epi8(char(0xE0 - 0x80)));
+                const __m256i fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8(char(0xF0 - 0x80)));
+                const __m256i must23 = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(char(0x80)));
+                return _mm256_xor_si256(must23, special);
+            }
+
+            inline uint32_t ascii_special_mask(const __m256i v)noexcept {
+                const __m256i ctrl = _mm256_cmpeq_epi8(_mm256_min_epu8(v, _mm256_set1_epi8(0x1F)), v);
+                return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(
+                    _mm256_or_si256(ctrl, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(0x7F))),
+                    _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\"')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\'))))));
+            }
+#endif // JSON_AVX2
+
+            // Validates the string body starting at the non ASCII byte iter, block by block, up to the first
+            // '\"', '\\' or control character. Returns where the scalar lexer should resume (iter when there
+            // is not a whole block left, the start of a sequence cut by the buffer end), or nullptr on
+            // malformed UTF-8.
+            inline const char* validate_utf8(const char* const iter, const char* const end)noexcept {
+                const char* p = iter;
+#if defined(JSON_AVX2)
+                if (end - p >= 32) {
+                    __m256i prev = _mm256_setzero_si256();
+                    __m256i error = _mm256_setzero_si256();
+                    do {
+                        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+                        if (const uint32_t m = ascii_special_mask(v); m) {
+                            const int n = std::countr_zero(m);
+                            if (n == 0)
+                                break;
+                            // the string ends inside this block: blank out the rest with ASCII
+                            const __m256i tail = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(utf8::tail_mask + 32 - n));
+                            v = _mm256_or_si256(_mm256_andnot_si256(tail, v), _mm256_and_si256(tail, _mm256_set1_epi8(' ')));
+                            error = _mm256_or_si256(error, utf8_errors(v, prev));
+                            if (!_mm256_testz_si256(error, error))
+                                return nullptr;
+                            return p + n;
+                        }
+                        error = _mm256_or_si256(error, utf8_errors(v, prev));
+                        prev = v;
+                        p += 32;
+                    } while (end - p >= 32);
+                    if (!_mm256_testz_si256(error, error))
+                        return nullptr;
+                    return utf8_boundary(iter, p);
+                }
+#endif // JSON_AVX2
+#if defined(JSON_SSSE3)
+                if (end - p >= 16) {
+                    __m128i prev = _mm_setzero_si128();
+                    __m128i error = _mm_setzero_si128();
+                    do {
+                        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+                        if (const uint32_t m = ascii_special_mask_16(v); m) {
+                            const int n = std::countr_zero(m);
+                            if (n == 0)
+                                break;
+                            const __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(utf8::tail_mask + 32 - n));
+                            v = _mm_or_si128(_mm_andnot_si128(tail, v), _mm_and_si128(tail, _mm_set1_epi8(' ')));
+                            error = _mm_or_si128(error, utf8_errors_16(v, prev));
+                            if (_mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) != 0xFFFF)
+                                return nullptr;
+                            return p + n;
+                        }
+                        error = _mm_or_si128(error, utf8_errors_16(v, prev));
+                        prev = v;
+                        p += 16;
+                    } while (end - p >= 16);
+                    if (_mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) != 0xFFFF)
+                        return nullptr;
+                    return utf8_boundary(iter, p);
+                }
+#endif // JSON_SSSE3
+                return p;
+            }
+
+            // Bitmaps of one 64-byte block, bit i stands for p[i].
+            struct block_masks {
+                uint64_t quote;
+                uint64_t backslash;
+                uint64_t op;        // { } [ ] : ,
+                uint64_t space;     // same set as lexer::is_space
+            };
+
+#if defined(JSON_AVX2)
+            inline void classify_32(const char* p, block_masks& m, const int shift)noexcept {
+                const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+                // '[' | 0x20 == '{' and ']' | 0x20 == '}'
+                const __m256i lower = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+                const __m256i op = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(lower, _mm256_set1_epi8('{')), _mm256_cmpeq_epi8(lower, _mm256_set1_epi8('}'))),
+                    _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(':')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8(','))));
+                const __m256i space = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n'))),
+                    _mm256_or_si256(
+                        _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r'))),
+                        _mm256_cmpeq_epi8(v, _mm256_setzero_si256())));
+                m.quote |= uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\"'))))) << shift;
+                m.backslash |= uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\'))))) << shift;
+                m.op |= uint64_t(uint32_t(_mm256_movemask_epi8(op))) << shift;
+                m.space |= uint64_t(uint32_t(_mm256_movemask_epi8(space))) << shift;
+            }
+#elif defined(JSON_SSE2)
+            inline void classify_16(const char* p, block_masks& m, const int shift)noexcept {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+                const __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+                const __m128i op = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(lower, _mm_set1_epi8('{')), _mm_cmpeq_epi8(lower, _mm_set1_epi8('}'))),
+                    _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(':')), _mm_cmpeq_epi8(v, _mm_set1_epi8(','))));
+                const __m128i space = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\n'))),
+                    _mm_or_si128(
+                        _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\t')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\r'))),
+                        _mm_cmpeq_epi8(v, _mm_setzero_si128())));
+                m.quote |= uint64_t(uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('\"'))))) << shift;
+                m.backslash |= uint64_t(uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('\\'))))) << shift;
+                m.op |= uint64_t(uint32_t(_mm_movemask_epi8(op))) << shift;
+                m.space |= uint64_t(uint32_t(_mm_movemask_epi8(space))) << shift;
+            }
+#endif // JSON_AVX2
+
+            inline block_masks classify(const char* p)noexcept {
+                block_masks m{};
+#if defined(JSON_AVX2)
+                classify_32(p, m, 0);
+                classify_32(p + 32, m, 32);
+#elif defined(JSON_SSE2)
+                classify_16(p, m, 0);
+                classify_16(p + 16, m, 16);
+                classify_16(p + 32, m, 32);
+                classify_16(p + 48, m, 48);
+#else
+                for (int i = 0; i < 64; ++i) {
+                    const uint64_t bit = uint64_t(1) << i;
+                    switch (p[i]) {
+                        case '\"':
+                            m.quote |= bit;
+                            break;
+                        case '\\':
+                            m.backslash |= bit;
+                            break;
+                        case '{':
+                        case '}':
+                        case '[':
+                        case ']':
+                        case ':':
+                        case ',':
+                            m.op |= bit;
+                            break;
+                        case ' ':
+                        case '\n':
+                        case '\t':
+                        case '\r':
+                        case '\0':
+                            m.space |= bit;
+                            break;
+                    }
+                }
+#endif // JSON_AVX2
+                return m;
+            }
+
+            // Bit i of the result is the xor of bits 0..i of x: with x the quote bitmap that marks every
+            // character from an opening quote up to (not including) the closing one.
+            inline uint64_t prefix_xor(uint64_t x)noexcept {
+#if defined(JSON_SSE2) and defined(__PCLMUL__)
+                return static_cast<uint64_t>(_mm_cvtsi128_si64(
+                    _mm_clmulepi64_si128(_mm_set_epi64x(0, static_cast<int64_t>(x)), _mm_set1_epi8(char(0xFF)), 0)));
+#else
+                x ^= x << 1;
+                x ^= x << 2;
+                x ^= x << 4;
+                x ^= x << 8;
+                x ^= x << 16;
+                x ^= x << 32;
+                return x;
+#endif // __PCLMUL__
+            }
+
+            // Characters preceded by an odd number of backslashes, prev_escaped carries a backslash run
+            // that crosses the block boundary.
+            inline uint64_t find_escaped(uint64_t backslash, uint64_t& prev_escaped)noexcept {
+                if (!backslash) {
+                    const uint64_t escaped = prev_escaped;
+                    prev_escaped = 0;
+                    return escaped;
+                }
+                backslash &= ~prev_escaped;
+                const uint64_t follows_escape = backslash << 1 | prev_escaped;
+                constexpr uint64_t even_bits = 0x5555555555555555;
+                const uint64_t odd_sequence_starts = backslash & ~even_bits & ~follows_escape;
+                const uint64_t sequences_starting_on_even_bits = odd_sequence_starts + backslash;
+                prev_escaped = sequences_starting_on_even_bits < odd_sequence_starts;
+                const uint64_t invert_mask = sequences_starting_on_even_bits << 1;
+                return (even_bits ^ invert_mask) & follows_escape;
+            }
+        }
+
+        // Four hex digits decoded at once: every byte is range-checked for 0-9 / a-f / A-F with
+        // borrow-free adds, then the nibbles are gathered into one code unit.
+        constexpr std::optional<uint32_t> decode_hex4(const char* const p)noexcept {
+            const uint32_t v = uint32_t(uint8_t(p[0])) | uint32_t(uint8_t(p[1])) << 8
+                | uint32_t(uint8_t(p[2])) << 16 | uint32_t(uint8_t(p[3])) << 24;
+            if (v & 0x80808080)
+                return std::nullopt;
+            const uint32_t digit = (v + 0x50505050) & ~(v + 0x46464646);                 // '0' <= c <= '9'
+            const uint32_t lower = v | 0x20202020;
+            const uint32_t letter = (lower + 0x1F1F1F1F) & ~(lower + 0x19191919);        // 'a' <= (c | 0x20) <= 'f'
+            if (((digit | letter) & 0x80808080) != 0x80808080)
+                return std::nullopt;
+            uint32_t x = (v & 0x0F0F0F0F) + ((letter >> 7) & 0x01010101) * 9;
+            x = (x & 0x000F000F) << 4 | (x >> 8 & 0x000F000F);
+            return (x & 0xFF) << 8 | (x >> 16 & 0xFF);
+        }
+
+        // Writes the UTF-8 encoding of uc to out (at least 4 bytes), returns its length.
+        constexpr size_t encode_utf8(const uint32_t uc, char* const out)noexcept {
+            if (uc <= 0x7F) {
+                out[0] = static_cast<char>(uc);
+                return 1;
+            }
+            if (uc <= 0x7FF) {
+                out[0] = static_cast<char>(0xC0 | (uc >> 6));
+                out[1] = static_cast<char>(0x80 | (uc & 0x3F));
+                return 2;
+            }
+            if (uc <= 0xFFFF) {
+                out[0] = static_cast<char>(0xE0 | (uc >> 12));
+                out[1] = static_cast<char>(0x80 | ((uc >> 6) & 0x3F));
+                out[2] = static_cast<char>(0x80 | (uc & 0x3F));
+                return 3;
+            }
+            if (uc <= 0x10FFFF) {
+                out[0] = static_cast<char>(0xF0 | (uc >> 18));
+                out[1] = static_cast<char>(0x80 | ((uc >> 12) & 0x3F));
+                out[2] = static_cast<char>(0x80 | ((uc >> 6) & 0x3F));
+                out[3] = static_cast<char>(0x80 | (uc & 0x3F));
+                return 4;
+            }
+            return 0;
+        }
+
+        // Length of the well-formed UTF-8 sequence at p, 0 when it is malformed, -1 when end cuts it.
+        inline int utf8_sequence_length(const char* const p, const char* const end)noexcept {
+            const auto lead = static_cast<uint8_t>(*p);
+            int n = 0;
+            uint8_t lower = 0x80, upper = 0xBF;
+            if (lead >= 0xC2 and lead <= 0xDF)
+                n = 2;
+            else if (lead >= 0xE0 and lead <= 0xEF) {
+                n = 3;
+                if (lead == 0xE0)
+                    lower = 0xA0;
+                else if (lead == 0xED)
+                    upper = 0x9F;
+            }
+            else if (lead >= 0xF0 and lead <= 0xF4) {
+                n = 4;
+                if (lead == 0xF0)
+                    lower = 0x90;
+                else if (lead == 0xF4)
+                    upper = 0x8F;
+            }
+            else return 0;
+            for (int i = 1; i < n; ++i) {
+                if (p + i == end)
+                    return -1;
+                const auto c = static_cast<uint8_t>(p[i]);
+                if (c < lower or c > upper)
+                    return 0;
+                lower = 0x80;
+                upper = 0xBF;
+            }
+            return n;
+        }
+
+        // Truncated 128-bit powers of five from 5^-342 to 5^308, high word first.
+        inline constexpr uint64_t power_of_five_128[] = {
+            0xeef453d6923bd65a, 0x113faa2906a13b3f,
+            0x9558b4661b6565f8, 0x4ac7ca59a424c507,
+            0xbaaee17fa23ebf76, 0x5d79bcf00d2df649,
+            0xe95a99df8ace6f53, 0xf4d82c2c107973dc,
+            0x91d8a02bb6c10594, 0x79071b9b8a4be869,
+            0xb64ec836a47146f9, 0x9748e2826cdee284,
+            0xe3e27a444d8d98b7, 0xfd1b1b2308169b25,
+            0x8e6d8c6ab0787f72, 0xfe30f0f5e50e20f7,
+            0xb208ef855c969f4f, 0xbdbd2d335e51a935,
+            0xde8b2b66b3bc4723, 0xad2c788035e61382,
+            0x8b16fb203055ac76, 0x4c3bcb5021afcc31,
+            0xaddcb9e83c6b1793, 0xdf4abe242a1bbf3d,
+            0xd953e8624b85dd78, 0xd71d6dad34a2af0d,
+            0x87d4713d6f33aa6b, 0x8672648c40e5ad68,
+            0xa9c98d8ccb009506, 0x680efdaf511f18c2,
+            0xd43bf0effdc0ba48, 0x0212bd1b2566def2,
+            0x84a57695fe98746d, 0x014bb630f7604b57,
+            0xa5ced43b7e3e9188, 0x419ea3bd35385e2d,
+            0xcf42894a5dce35ea, 0x52064cac828675b9,
+            0x818995ce7aa0e1b2, 0x7343efebd1940993,
+            0xa1ebfb4219491a1f, 0x1014ebe6c5f90bf8,
+            0xca66fa129f9b60a6, 0xd41a26e077774ef6,
+            0xfd00b897478238d0, 0x8920b098955522b4,
+            0x9e20735e8cb16382, 0x55b46e5f5d5535b0,
+            0xc5a890362fddbc62, 0xeb2189f734aa831d,
+            0xf712b443bbd52b7b, 0xa5e9ec7501d523e4,
+            0x9a6bb0aa55653b2d, 0x47b233c92125366e,
+            0xc1069cd4eabe89f8, 0x999ec0bb696e840a,
+            0xf148440a256e2c76, 0xc00670ea43ca250d,
+            0x96cd2a865764dbca, 0x380406926a5e5728,
+            0xbc807527ed3e12bc, 0xc605083704f5ecf2,
+            0xeba09271e88d976b, 0xf7864a44c633682e,
+            0x93445b8731587ea3, 0x7ab3ee6afbe0211d,
+            0xb8157268fdae9e4c, 0x5960ea05bad82964,
+            0xe61acf033d1a45df, 0x6fb92487298e33bd,
+            0x8fd0c16206306bab, 0xa5d3b6d479f8e056,
+            0xb3c4f1ba87bc8696, 0x8f48a4899877186c,
+            0xe0b62e2929aba83c, 0x331acdabfe94de87,
+            0x8c71dcd9ba0b4925, 0x9ff0c08b7f1d0b14,
+            0xaf8e5410288e1b6f, 0x07ecf0ae5ee44dd9,
+            0xdb71e91432b1a24a, 0xc9e82cd9f69d6150,
+            0x892731ac9faf056e, 0xbe311c083a225cd2,
+            0xab70fe17c79ac6ca, 0x6dbd630a48aaf406,
+            0xd64d3d9db981787d, 0x092cbbccdad5b108,
+            0x85f0468293f0eb4e, 0x25bbf56008c58ea5,
+            0xa76c582338ed2621, 0xaf2af2b80af6f24e,
+            0xd1476e2c07286faa, 0x1af5af660db4aee1,
+            0x82cca4db847945ca, 0x50d98d9fc890ed4d,
+            0xa37fce126597973c, 0xe50ff107bab528a0,
+            0xcc5fc196fefd7d0c, 0x1e53ed49a96272c8,
+            0xff77b1fcbebcdc4f, 0x25e8e89c13bb0f7a,
+            0x9faacf3df73609b1, 0x77b191618c54e9ac,
+            0xc795830d75038c1d, 0xd59df5b9ef6a2417,
+            0xf97ae3d0d2446f25, 0x4b0573286b44ad1d,
+            0x9becce62836ac577, 0x4ee367f9430aec32,
+            0xc2e801fb244576d5, 0x229c41f793cda73f,
+            0xf3a20279ed56d48a, 0x6b43527578c1110f,
+            0x9845418c345644d6, 0x830a13896b78aaa9,
+            0xbe5691ef416bd60c, 0x23cc986bc656d553,
+            0xedec366b11c6cb8f, 0x2cbfbe86b7ec8aa8,
+            0x94b3a202eb1c3f39, 0x7bf7d71432f3d6a9,
+            0xb9e08a83a5e34f07, 0xdaf5ccd93fb0cc53,
+            0xe858ad248f5c22c9, 0xd1b3400f8f9cff68,
+            0x91376c36d99995be, 0x23100809b9c21fa1,
+            0xb58547448ffffb2d, 0xabd40a0c2832a78a,
+            0xe2e69915b3fff9f9, 0x16c90c8f323f516c,
+            0x8dd01fad907ffc3b, 0xae3da7d97f6792e3,
+            0xb1442798f49ffb4a, 0x99cd11cfdf41779c,
+            0xdd95317f31c7fa1d, 0x40405643d711d583,
+            0x8a7d3eef7f1cfc52, 0x482835ea666b2572,
+            0xad1c8eab5ee43b66, 0xda3243650005eecf,
+            0xd863b256369d4a40, 0x90bed43e40076a82,
+            0x873e4f75e2224e68, 0x5a7744a6e804a291,
+            0xa90de3535aaae202, 0x711515d0a205cb36,
+            0xd3515c2831559a83, 0x0d5a5b44ca873e03,
+            0x8412d9991ed58091, 0xe858790afe9486c2,
+            0xa5178fff668ae0b6, 0x626e974dbe39a872,
+            0xce5d73ff402d98e3, 0xfb0a3d212dc8128f,
+            0x80fa687f881c7f8e, 0x7ce66634bc9d0b99,
+            0xa139029f6a239f72, 0x1c1fffc1ebc44e80,
+            0xc987434744ac874e, 0xa327ffb266b56220,
+            0xfbe9141915d7a922, 0x4bf1ff9f0062baa8,
+            0x9d71ac8fada6c9b5, 0x6f773fc3603db4a9,
+            0xc4ce17b399107c22, 0xcb550fb4384d21d3,
+            0xf6019da07f549b2b, 0x7e2a53a146606a48,
+            0x99c102844f94e0fb, 0x2eda7444cbfc426d,
+            0xc0314325637a1939, 0xfa911155fefb5308,
+            0xf03d93eebc589f88, 0x793555ab7eba27ca,
+            0x96267c7535b763b5, 0x4bc1558b2f3458de,
+            0xbbb01b9283253ca2, 0x9eb1aaedfb016f16,
+            0xea9c227723ee8bcb, 0x465e15a979c1cadc,
+            0x92a1958a7675175f, 0x0bfacd89ec191ec9,
+            0xb749faed14125d36, 0xcef980ec671f667b,
+            0xe51c79a85916f484, 0x82b7e12780e7401a,
+            0x8f31cc0937ae58d2, 0xd1b2ecb8b0908810,
+            0xb2fe3f0b8599ef07, 0x861fa7e6dcb4aa15,
+            0xdfbdcece67006ac9, 0x67a791e093e1d49a,
+            0x8bd6a141006042bd, 0xe0c8bb2c5c6d24e0,
+            0xaecc49914078536d, 0x58fae9f773886e18,
+            0xda7f5bf590966848, 0xaf39a475506a899e,
+            0x888f99797a5e012d, 0x6d8406c952429603,
+            0xaab37fd7d8f58178, 0xc8e5087ba6d33b83,
+            0xd5605fcdcf32e1d6, 0xfb1e4a9a90880a64,
+            0x855c3be0a17fcd26, 0x5cf2eea09a55067f,
+            0xa6b34ad8c9dfc06f, 0xf42faa48c0ea481e,
+            0xd0601d8efc57b08b, 0xf13b94daf124da26,
+            0x823c12795db6ce57, 0x76c53d08d6b70858,
+            0xa2cb1717b52481ed, 0x54768c4b0c64ca6e,
+            0xcb7ddcdda26da268, 0xa9942f5dcf7dfd09,
+            0xfe5d54150b090b02, 0xd3f93b35435d7c4c,
+            0x9efa548d26e5a6e1, 0xc47bc5014a1a6daf,
+            0xc6b8e9b0709f109a, 0x359ab6419ca1091b,
+            0xf867241c8cc6d4c0, 0xc30163d203c94b62,
+            0x9b407691d7fc44f8, 0x79e0de63425dcf1d,
+            0xc21094364dfb5636, 0x985915fc12f542e4,
+            0xf294b943e17a2bc4, 0x3e6f5b7b17b2939d,
+            0x979cf3ca6cec5b5a, 0xa705992ceecf9c42,
+            0xbd8430bd08277231, 0x50c6ff782a838353,
+            0xece53cec4a314ebd, 0xa4f8bf5635246428,
+            0x940f4613ae5ed136, 0x871b7795e136be99,
+            0xb913179899f68584, 0x28e2557b59846e3f,
+            0xe757dd7ec07426e5, 0x331aeada2fe589cf,
+            0x9096ea6f3848984f, 0x3ff0d2c85def7621,
+            0xb4bca50b065abe63, 0x0fed077a756b53a9,
+            0xe1ebce4dc7f16dfb, 0xd3e8495912c62894,
+            0x8d3360f09cf6e4bd, 0x64712dd7abbbd95c,
+            0xb080392cc4349dec, 0xbd8d794d96aacfb3,
+            0xdca04777f541c567, 0xecf0d7a0fc5583a0,
+            0x89e42caaf9491b60, 0xf41686c49db57244,
+            0xac5d37d5b79b6239, 0x311c2875c522ced5,
+            0xd77485cb25823ac7, 0x7d633293366b828b,
+            0x86a8d39ef77164bc, 0xae5dff9c02033197,
+            0xa8530886b54dbdeb, 0xd9f57f830283fdfc,
+            0xd267caa862a12d66, 0xd072df63c324fd7b,
+            0x8380dea93da4bc60, 0x4247cb9e59f71e6d,
+            0xa46116538d0deb78, 0x52d9be85f074e608,
+            0xcd795be870516656, 0x67902e276c921f8b,
+            0x806bd9714632dff6, 0x00ba1cd8a3db53b6,
+            0xa086cfcd97bf97f3, 0x80e8a40eccd228a4,
+            0xc8a883c0fdaf7df0, 0x6122cd128006b2cd,
+            0xfad2a4b13d1b5d6c, 0x796b805720085f81,
+            0x9cc3a6eec6311a63, 0xcbe3303674053bb0,
+            0xc3f490aa77bd60fc, 0xbedbfc4411068a9c,
+            0xf4f1b4d515acb93b, 0xee92fb5515482d44,
+            0x991711052d8bf3c5, 0x751bdd152d4d1c4a,
+            0xbf5cd54678eef0b6, 0xd262d45a78a0635d,
+            0xef340a98172aace4, 0x86fb897116c87c34,
+            0x9580869f0e7aac0e, 0xd45d35e6ae3d4da0,
+            0xbae0a846d2195712, 0x8974836059cca109,
+            0xe998d258869facd7, 0x2bd1a438703fc94b,
+            0x91ff83775423cc06, 0x7b6306a34627ddcf,
+            0xb67f6455292cbf08, 0x1a3bc84c17b1d542,
+            0xe41f3d6a7377eeca, 0x20caba5f1d9e4a93,
+            0x8e938662882af53e, 0x547eb47b7282ee9c,
+            0xb23867fb2a35b28d, 0xe99e619a4f23aa43,
+            0xdec681f9f4c31f31, 0x6405fa00e2ec94d4,
+            0x8b3c113c38f9f37e, 0xde83bc408dd3dd04,
+            0xae0b158b4738705e, 0x9624ab50b148d445,
+            0xd98ddaee19068c76, 0x3badd624dd9b0957,
+            0x87f8a8d4cfa417c9, 0xe54ca5d70a80e5d6,
+            0xa9f6d30a038d1dbc, 0x5e9fcf4ccd211f4c,
+            0xd47487cc8470652b, 0x7647c3200069671f,
+            0x84c8d4dfd2c63f3b, 0x29ecd9f40041e073,
+            0xa5fb0a17c777cf09, 0xf468107100525890,
+            0xcf79cc9db955c2cc, 0x7182148d4066eeb4,
+            0x81ac1fe293d599bf, 0xc6f14cd848405530,
+            0xa21727db38cb002f, 0xb8ada00e5a506a7c,
+            0xca9cf1d206fdc03b, 0xa6d90811f0e4851c,
+            0xfd442e4688bd304a, 0x908f4a166d1da663,
+            0x9e4a9cec15763e2e, 0x9a598e4e043287fe,
+            0xc5dd44271ad3cdba, 0x40eff1e1853f29fd,
+            0xf7549530e188c128, 0xd12bee59e68ef47c,
+            0x9a94dd3e8cf578b9, 0x82bb74f8301958ce,
+            0xc13a148e3032d6e7, 0xe36a52363c1faf01,
+            0xf18899b1bc3f8ca1, 0xdc44e6c3cb279ac1,
+            0x96f5600f15a7b7e5, 0x29ab103a5ef8c0b9,
+            0xbcb2b812db11a5de, 0x7415d448f6b6f0e7,
+            0xebdf661791d60f56, 0x111b495b3464ad21,
+            0x936b9fcebb25c995, 0xcab10dd900beec34,
+            0xb84687c269ef3bfb, 0x3d5d514f40eea742,
+            0xe65829b3046b0afa, 0x0cb4a5a3112a5112,
+            0x8ff71a0fe2c2e6dc, 0x47f0e785eaba72ab,
+            0xb3f4e093db73a093, 0x59ed216765690f56,
+            0xe0f218b8d25088b8, 0x306869c13ec3532c,
+            0x8c974f7383725573, 0x1e414218c73a13fb,
+            0xafbd2350644eeacf, 0xe5d1929ef90898fa,
+            0xdbac6c247d62a583, 0xdf45f746b74abf39,
+            0x894bc396ce5da772, 0x6b8bba8c328eb783,
+            0xab9eb47c81f5114f, 0x066ea92f3f326564,
+            0xd686619ba27255a2, 0xc80a537b0efefebd,
+            0x8613fd0145877585, 0xbd06742ce95f5f36,
+            0xa798fc4196e952e7, 0x2c48113823b73704,
+            0xd17f3b51fca3a7a0, 0xf75a15862ca504c5,
+            0x82ef85133de648c4, 0x9a984d73dbe722fb,
+            0xa3ab66580d5fdaf5, 0xc13e60d0d2e0ebba,
+            0xcc963fee10b7d1b3, 0x318df905079926a8,
+            0xffbbcfe994e5c61f, 0xfdf17746497f7052,
+            0x9fd561f1fd0f9bd3, 0xfeb6ea8bedefa633,
+            0xc7caba6e7c5382c8, 0xfe64a52ee96b8fc0,
+            0xf9bd690a1b68637b, 0x3dfdce7aa3c673b0,
+            0x9c1661a651213e2d, 0x06bea10ca65c084e,
+            0xc31bfa0fe5698db8, 0x486e494fcff30a62,
+            0xf3e2f893dec3f126, 0x5a89dba3c3efccfa,
+            0x986ddb5c6b3a76b7, 0xf89629465a75e01c,
+            0xbe89523386091465, 0xf6bbb397f1135823,
+            0xee2ba6c0678b597f, 0x746aa07ded582e2c,
+            0x94db483840b717ef, 0xa8c2a44eb4571cdc,
+            0xba121a4650e4ddeb, 0x92f34d62616ce413,
+            0xe896a0d7e51e1566, 0x77b020baf9c81d17,
+            0x915e2486ef32cd60, 0x0ace1474dc1d122e,
+            0xb5b5ada8aaff80b8, 0x0d819992132456ba,
+            0xe3231912d5bf60e6, 0x10e1fff697ed6c69,
+            0x8df5efabc5979c8f, 0xca8d3ffa1ef463c1,
+            0xb1736b96b6fd83b3, 0xbd308ff8a6b17cb2,
+            0xddd0467c64bce4a0, 0xac7cb3f6d05ddbde,
+            0x8aa22c0dbef60ee4, 0x6bcdf07a423aa96b,
+            0xad4ab7112eb3929d, 0x86c16c98d2c953c6,
+            0xd89d64d57a607744, 0xe871c7bf077ba8b7,
+            0x87625f056c7c4a8b, 0x11471cd764ad4972,
+            0xa93af6c6c79b5d2d, 0xd598e40d3dd89bcf,
+            0xd389b47879823479, 0x4aff1d108d4ec2c3,
+            0x843610cb4bf160cb, 0xcedf722a585139ba,
+            0xa54394fe1eedb8fe, 0xc2974eb4ee658828,
+            0xce947a3da6a9273e, 0x733d226229feea32,
+            0x811ccc668829b887, 0x0806357d5a3f525f,
+            0xa163ff802a3426a8, 0xca07c2dcb0cf26f7,
+            0xc9bcff6034c13052, 0xfc89b393dd02f0b5,
+            0xfc2c3f3841f17c67, 0xbbac2078d443ace2,
+            0x9d9ba7832936edc0, 0xd54b944b84aa4c0d,
+            0xc5029163f384a931, 0x0a9e795e65d4df11,
+            0xf64335bcf065d37d, 0x4d4617b5ff4a16d5,
+            0x99ea0196163fa42e, 0x504bced1bf8e4e45,
+            0xc06481fb9bcf8d39, 0xe45ec2862f71e1d6,
+            0xf07da27a82c37088, 0x5d767327bb4e5a4c,
+            0x964e858c91ba2655, 0x3a6a07f8d510f86f,
+            0xbbe226efb628afea, 0x890489f70a55368b,
+            0xeadab0aba3b2dbe5, 0x2b45ac74ccea842e,
+            0x92c8ae6b464fc96f, 0x3b0b8bc90012929d,
+            0xb77ada0617e3bbcb, 0x09ce6ebb40173744,
+            0xe55990879ddcaabd, 0xcc420a6a101d0515,
+            0x8f57fa54c2a9eab6, 0x9fa946824a12232d,
+            0xb32df8e9f3546564, 0x47939822dc96abf9,
+            0xdff9772470297ebd, 0x59787e2b93bc56f7,
+            0x8bfbea76c619ef36, 0x57eb4edb3c55b65a,
+            0xaefae51477a06b03, 0xede622920b6b23f1,
+            0xdab99e59958885c4, 0xe95fab368e45eced,
+            0x88b402f7fd75539b, 0x11dbcb0218ebb414,
+            0xaae103b5fcd2a881, 0xd652bdc29f26a119,
+            0xd59944a37c0752a2, 0x4be76d3346f0495f,
+            0x857fcae62d8493a5, 0x6f70a4400c562ddb,
+            0xa6dfbd9fb8e5b88e, 0xcb4ccd500f6bb952,
+            0xd097ad07a71f26b2, 0x7e2000a41346a7a7,
+            0x825ecc24c873782f, 0x8ed400668c0c28c8,
+            0xa2f67f2dfa90563b, 0x728900802f0f32fa,
+            0xcbb41ef979346bca, 0x4f2b40a03ad2ffb9,
+            0xfea126b7d78186bc, 0xe2f610c84987bfa8,
+            0x9f24b832e6b0f436, 0x0dd9ca7d2df4d7c9,
+            0xc6ede63fa05d3143, 0x91503d1c79720dbb,
+            0xf8a95fcf88747d94, 0x75a44c6397ce912a,
+            0x9b69dbe1b548ce7c, 0xc986afbe3ee11aba,
+            0xc24452da229b021b, 0xfbe85badce996168,
+            0xf2d56790ab41c2a2, 0xfae27299423fb9c3,
+            0x97c560ba6b0919a5, 0xdccd879fc967d41a,
+            0xbdb6b8e905cb600f, 0x5400e987bbc1c920,
+            0xed246723473e3813, 0x290123e9aab23b68,
+            0x9436c0760c86e30b, 0xf9a0b6720aaf6521,
+            0xb94470938fa89bce, 0xf808e40e8d5b3e69,
+            0xe7958cb87392c2c2, 0xb60b1d1230b20e04,
+            0x90bd77f3483bb9b9, 0xb1c6f22b5e6f48c2,
+            0xb4ecd5f01a4aa828, 0x1e38aeb6360b1af3,
+            0xe2280b6c20dd5232, 0x25c6da63c38de1b0,
+            0x8d590723948a535f, 0x579c487e5a38ad0e,
+            0xb0af48ec79ace837, 0x2d835a9df0c6d851,
+            0xdcdb1b2798182244, 0xf8e431456cf88e65,
+            0x8a08f0f8bf0f156b, 0x1b8e9ecb641b58ff,
+            0xac8b2d36eed2dac5, 0xe272467e3d222f3f,
+            0xd7adf884aa879177, 0x5b0ed81dcc6abb0f,
+            0x86ccbb52ea94baea, 0x98e947129fc2b4e9,
+            0xa87fea27a539e9a5, 0x3f2398d747b36224,
+            0xd29fe4b18e88640e, 0x8eec7f0d19a03aad,
+            0x83a3eeeef9153e89, 0x1953cf68300424ac,
+            0xa48ceaaab75a8e2b, 0x5fa8c3423c052dd7,
+            0xcdb02555653131b6, 0x3792f412cb06794d,
+            0x808e17555f3ebf11, 0xe2bbd88bbee40bd0,
+            0xa0b19d2ab70e6ed6, 0x5b6aceaeae9d0ec4,
+            0xc8de047564d20a8b, 0xf245825a5a445275,
+            0xfb158592be068d2e, 0xeed6e2f0f0d56712,
+            0x9ced737bb6c4183d, 0x55464dd69685606b,
+            0xc428d05aa4751e4c, 0xaa97e14c3c26b886,
+            0xf53304714d9265df, 0xd53dd99f4b3066a8,
+            0x993fe2c6d07b7fab, 0xe546a8038efe4029,
+            0xbf8fdb78849a5f96, 0xde98520472bdd033,
+            0xef73d256a5c0f77c, 0x963e66858f6d4440,
+            0x95a8637627989aad, 0xdde7001379a44aa8,
+            0xbb127c53b17ec159, 0x5560c018580d5d52,
+            0xe9d71b689dde71af, 0xaab8f01e6e10b4a6,
+            0x9226712162ab070d, 0xcab3961304ca70e8,
+            0xb6b00d69bb55c8d1, 0x3d607b97c5fd0d22,
+            0xe45c10c42a2b3b05, 0x8cb89a7db77c506a,
+            0x8eb98a7a9a5b04e3, 0x77f3608e92adb242,
+            0xb267ed1940f1c61c, 0x55f038b237591ed3,
+            0xdf01e85f912e37a3, 0x6b6c46dec52f6688,
+            0x8b61313bbabce2c6, 0x2323ac4b3b3da015,
+            0xae397d8aa96c1b77, 0xabec975e0a0d081a,
+            0xd9c7dced53c72255, 0x96e7bd358c904a21,
+            0x881cea14545c7575, 0x7e50d64177da2e54,
+            0xaa242499697392d2, 0xdde50bd1d5d0b9e9,
+            0xd4ad2dbfc3d07787, 0x955e4ec64b44e864,
+            0x84ec3c97da624ab4, 0xbd5af13bef0b113e,
+            0xa6274bbdd0fadd61, 0xecb1ad8aeacdd58e,
+            0xcfb11ead453994ba, 0x67de18eda5814af2,
+            0x81ceb32c4b43fcf4, 0x80eacf948770ced7,
+            0xa2425ff75e14fc31, 0xa1258379a94d028d,
+            0xcad2f7f5359a3b3e, 0x096ee45813a04330,
+            0xfd87b5f28300ca0d, 0x8bca9d6e188853fc,
+            0x9e74d1b791e07e48, 0x775ea264cf55347e,
+            0xc612062576589dda, 0x95364afe032a819e,
+            0xf79687aed3eec551, 0x3a83ddbd83f52205,
+            0x9abe14cd44753b52, 0xc4926a9672793543,
+            0xc16d9a0095928a27, 0x75b7053c0f178294,
+            0xf1c90080baf72cb1, 0x5324c68b12dd6339,
+            0x971da05074da7bee, 0xd3f6fc16ebca5e04,
+            0xbce5086492111aea, 0x88f4bb1ca6bcf585,
+            0xec1e4a7db69561a5, 0x2b31e9e3d06c32e6,
+            0x9392ee8e921d5d07, 0x3aff322e62439fd0,
+            0xb877aa3236a4b449, 0x09befeb9fad487c3,
+            0xe69594bec44de15b, 0x4c2ebe687989a9b4,
+            0x901d7cf73ab0acd9, 0x0f9d37014bf60a11,
+            0xb424dc35095cd80f, 0x538484c19ef38c95,
+            0xe12e13424bb40e13, 0x2865a5f206b06fba,
+            0x8cbccc096f5088cb, 0xf93f87b7442e45d4,
+            0xafebff0bcb24aafe, 0xf78f69a51539d749,
+            0xdbe6fecebdedd5be, 0xb573440e5a884d1c,
+            0x89705f4136b4a597, 0x31680a88f8953031,
+            0xabcc77118461cefc, 0xfdc20d2b36ba7c3e,
+            0xd6bf94d5e57a42bc, 0x3d32907604691b4d,
+            0x8637bd05af6c69b5, 0xa63f9a49c2c1b110,
+            0xa7c5ac471b478423, 0x0fcf80dc33721d54,
+            0xd1b71758e219652b, 0xd3c36113404ea4a9,
+            0x83126e978d4fdf3b, 0x645a1cac083126ea,
+            0xa3d70a3d70a3d70a, 0x3d70a3d70a3d70a4,
+            0xcccccccccccccccc, 0xcccccccccccccccd,
+            0x8000000000000000, 0x0000000000000000,
+            0xa000000000000000, 0x0000000000000000,
+            0xc800000000000000, 0x0000000000000000,
+            0xfa00000000000000, 0x0000000000000000,
+            0x9c40000000000000, 0x0000000000000000,
+            0xc350000000000000, 0x0000000000000000,
+            0xf424000000000000, 0x0000000000000000,
+            0x9896800000000000, 0x0000000000000000,
+            0xbebc200000000000, 0x0000000000000000,
+            0xee6b280000000000, 0x0000000000000000,
+            0x9502f90000000000, 0x0000000000000000,
+            0xba43b74000000000, 0x0000000000000000,
+            0xe8d4a51000000000, 0x0000000000000000,
+            0x9184e72a00000000, 0x0000000000000000,
+            0xb5e620f480000000, 0x0000000000000000,
+            0xe35fa931a0000000, 0x0000000000000000,
+            0x8e1bc9bf04000000, 0x0000000000000000,
+            0xb1a2bc2ec5000000, 0x0000000000000000,
+            0xde0b6b3a76400000, 0x0000000000000000,
+            0x8ac7230489e80000, 0x0000000000000000,
+            0xad78ebc5ac620000, 0x0000000000000000,
+            0xd8d726b7177a8000, 0x0000000000000000,
+            0x878678326eac9000, 0x0000000000000000,
+            0xa968163f0a57b400, 0x0000000000000000,
+            0xd3c21bcecceda100, 0x0000000000000000,
+            0x84595161401484a0, 0x0000000000000000,
+            0xa56fa5b99019a5c8, 0x0000000000000000,
+            0xcecb8f27f4200f3a, 0x0000000000000000,
+            0x813f3978f8940984, 0x4000000000000000,
+            0xa18f07d736b90be5, 0x5000000000000000,
+            0xc9f2c9cd04674ede, 0xa400000000000000,
+            0xfc6f7c4045812296, 0x4d00000000000000,
+            0x9dc5ada82b70b59d, 0xf020000000000000,
+            0xc5371912364ce305, 0x6c28000000000000,
+            0xf684df56c3e01bc6, 0xc732000000000000,
+            0x9a130b963a6c115c, 0x3c7f400000000000,
+            0xc097ce7bc90715b3, 0x4b9f100000000000,
+            0xf0bdc21abb48db20, 0x1e86d40000000000,
+            0x96769950b50d88f4, 0x1314448000000000,
+            0xbc143fa4e250eb31, 0x17d955a000000000,
+            0xeb194f8e1ae525fd, 0x5dcfab0800000000,
+            0x92efd1b8d0cf37be, 0x5aa1cae500000000,
+            0xb7abc627050305ad, 0xf14a3d9e40000000,
+            0xe596b7b0c643c719, 0x6d9ccd05d0000000,
+            0x8f7e32ce7bea5c6f, 0xe4820023a2000000,
+            0xb35dbf821ae4f38b, 0xdda2802c8a800000,
+            0xe0352f62a19e306e, 0xd50b2037ad200000,
+            0x8c213d9da502de45, 0x4526f422cc340000,
+            0xaf298d050e4395d6, 0x9670b12b7f410000,
+            0xdaf3f04651d47b4c, 0x3c0cdd765f114000,
+            0x88d8762bf324cd0f, 0xa5880a69fb6ac800,
+            0xab0e93b6efee0053, 0x8eea0d047a457a00,
+            0xd5d238a4abe98068, 0x72a4904598d6d880,
+            0x85a36366eb71f041, 0x47a6da2b7f864750,
+            0xa70c3c40a64e6c51, 0x999090b65f67d924,
+            0xd0cf4b50cfe20765, 0xfff4b4e3f741cf6d,
+            0x82818f1281ed449f, 0xbff8f10e7a8921a4,
+            0xa321f2d7226895c7, 0xaff72d52192b6a0d,
+            0xcbea6f8ceb02bb39, 0x9bf4f8a69f764490,
+            0xfee50b7025c36a08, 0x02f236d04753d5b4,
+            0x9f4f2726179a2245, 0x01d762422c946590,
+            0xc722f0ef9d80aad6, 0x424d3ad2b7b97ef5,
+            0xf8ebad2b84e0d58b, 0xd2e0898765a7deb2,
+            0x9b934c3b330c8577, 0x63cc55f49f88eb2f,
+            0xc2781f49ffcfa6d5, 0x3cbf6b71c76b25fb,
+            0xf316271c7fc3908a, 0x8bef464e3945ef7a,
+            0x97edd871cfda3a56, 0x97758bf0e3cbb5ac,
+            0xbde94e8e43d0c8ec, 0x3d52eeed1cbea317,
+            0xed63a231d4c4fb27, 0x4ca7aaa863ee4bdd,
+            0x945e455f24fb1cf8, 0x8fe8caa93e74ef6a,
+            0xb975d6b6ee39e436, 0xb3e2fd538e122b44,
+            0xe7d34c64a9c85d44, 0x60dbbca87196b616,
+            0x90e40fbeea1d3a4a, 0xbc8955e946fe31cd,
+            0xb51d13aea4a488dd, 0x6babab6398bdbe41,
+            0xe264589a4dcdab14, 0xc696963c7eed2dd1,
+            0x8d7eb76070a08aec, 0xfc1e1de5cf543ca2,
+            0xb0de65388cc8ada8, 0x3b25a55f43294bcb,
+            0xdd15fe86affad912, 0x49ef0eb713f39ebe,
+            0x8a2dbf142dfcc7ab, 0x6e3569326c784337,
+            0xacb92ed9397bf996, 0x49c2c37f07965404,
+            0xd7e77a8f87daf7fb, 0xdc33745ec97be906,
+            0x86f0ac99b4e8dafd, 0x69a028bb3ded71a3,
+            0xa8acd7c0222311bc, 0xc40832ea0d68ce0c,
+            0xd2d80db02aabd62b, 0xf50a3fa490c30190,
+            0x83c7088e1aab65db, 0x792667c6da79e0fa,
+            0xa4b8cab1a1563f52, 0x577001b891185938,
+            0xcde6fd5e09abcf26, 0xed4c0226b55e6f86,
+            0x80b05e5ac60b6178, 0x544f8158315b05b4,
+            0xa0dc75f1778e39d6, 0x696361ae3db1c721,
+            0xc913936dd571c84c, 0x03bc3a19cd1e38e9,
+            0xfb5878494ace3a5f, 0x04ab48a04065c723,
+            0x9d174b2dcec0e47b, 0x62eb0d64283f9c76,
+            0xc45d1df942711d9a, 0x3ba5d0bd324f8394,
+            0xf5746577930d6500, 0xca8f44ec7ee36479,
+            0x9968bf6abbe85f20, 0x7e998b13cf4e1ecb,
+            0xbfc2ef456ae276e8, 0x9e3fedd8c321a67e,
+            0xefb3ab16c59b14a2, 0xc5cfe94ef3ea101e,
+            0x95d04aee3b80ece5, 0xbba1f1d158724a12,
+            0xbb445da9ca61281f, 0x2a8a6e45ae8edc97,
+            0xea1575143cf97226, 0xf52d09d71a3293bd,
+            0x924d692ca61be758, 0x593c2626705f9c56,
+            0xb6e0c377cfa2e12e, 0x6f8b2fb00c77836c,
+            0xe498f455c38b997a, 0x0b6dfb9c0f956447,
+            0x8edf98b59a373fec, 0x4724bd4189bd5eac,
+            0xb2977ee300c50fe7, 0x58edec91ec2cb657,
+            0xdf3d5e9bc0f653e1, 0x2f2967b66737e3ed,
+            0x8b865b215899f46c, 0xbd79e0d20082ee74,
+            0xae67f1e9aec07187, 0xecd8590680a3aa11,
+            0xda01ee641a708de9, 0xe80e6f4820cc9495,
+            0x884134fe908658b2, 0x3109058d147fdcdd,
+            0xaa51823e34a7eede, 0xbd4b46f0599fd415,
+            0xd4e5e2cdc1d1ea96, 0x6c9e18ac7007c91a,
+            0x850fadc09923329e, 0x03e2cf6bc604ddb0,
+            0xa6539930bf6bff45, 0x84db8346b786151c,
+            0xcfe87f7cef46ff16, 0xe612641865679a63,
+            0x81f14fae158c5f6e, 0x4fcb7e8f3f60c07e,
+            0xa26da3999aef7749, 0xe3be5e330f38f09d,
+            0xcb090c8001ab551c, 0x5cadf5bfd3072cc5,
+            0xfdcb4fa002162a63, 0x73d9732fc7c8f7f6,
+            0x9e9f11c4014dda7e, 0x2867e7fddcdd9afa,
+            0xc646d63501a1511d, 0xb281e1fd541501b8,
+            0xf7d88bc24209a565, 0x1f225a7ca91a4226,
+            0x9ae757596946075f, 0x3375788de9b06958,
+            0xc1a12d2fc3978937, 0x0052d6b1641c83ae,
+            0xf209787bb47d6b84, 0xc0678c5dbd23a49a,
+            0x9745eb4d50ce6332, 0xf840b7ba963646e0,
+            0xbd176620a501fbff, 0xb650e5a93bc3d898,
+            0xec5d3fa8ce427aff, 0xa3e51f138ab4cebe,
+            0x93ba47c980e98cdf, 0xc66f336c36b10137,
+            0xb8a8d9bbe123f017, 0xb80b0047445d4184,
+            0xe6d3102ad96cec1d, 0xa60dc059157491e5,
+            0x9043ea1ac7e41392, 0x87c89837ad68db2f,
+            0xb454e4a179dd1877, 0x29babe4598c311fb,
+            0xe16a1dc9d8545e94, 0xf4296dd6fef3d67a,
+            0x8ce2529e2734bb1d, 0x1899e4a65f58660c,
+            0xb01ae745b101e9e4, 0x5ec05dcff72e7f8f,
+            0xdc21a1171d42645d, 0x76707543f4fa1f73,
+            0x899504ae72497eba, 0x6a06494a791c53a8,
+            0xabfa45da0edbde69, 0x0487db9d17636892,
+            0xd6f8d7509292d603, 0x45a9d2845d3c42b6,
+            0x865b86925b9bc5c2, 0x0b8a2392ba45a9b2,
+            0xa7f26836f282b732, 0x8e6cac7768d7141e,
+            0xd1ef0244af2364ff, 0x3207d795430cd926,
+            0x8335616aed761f1f, 0x7f44e6bd49e807b8,
+            0xa402b9c5a8d3a6e7, 0x5f16206c9c6209a6,
+            0xcd036837130890a1, 0x36dba887c37a8c0f,
+            0x802221226be55a64, 0xc2494954da2c9789,
+            0xa02aa96b06deb0fd, 0xf2db9baa10b7bd6c,
+            0xc83553c5c8965d3d, 0x6f92829494e5acc7,
+            0xfa42a8b73abbf48c, 0xcb772339ba1f17f9,
+            0x9c69a97284b578d7, 0xff2a760414536efb,
+            0xc38413cf25e2d70d, 0xfef5138519684aba,
+            0xf46518c2ef5b8cd1, 0x7eb258665fc25d69,
+            0x98bf2f79d5993802, 0xef2f773ffbd97a61,
+            0xbeeefb584aff8603, 0xaafb550ffacfd8fa,
+            0xeeaaba2e5dbf6784, 0x95ba2a53f983cf38,
+            0x952ab45cfa97a0b2, 0xdd945a747bf26183,
+            0xba756174393d88df, 0x94f971119aeef9e4,
+            0xe912b9d1478ceb17, 0x7a37cd5601aab85d,
+            0x91abb422ccb812ee, 0xac62e055c10ab33a,
+            0xb616a12b7fe617aa, 0x577b986b314d6009,
+            0xe39c49765fdf9d94, 0xed5a7e85fda0b80b,
+            0x8e41ade9fbebc27d, 0x14588f13be847307,
+            0xb1d219647ae6b31c, 0x596eb2d8ae258fc8,
+            0xde469fbd99a05fe3, 0x6fca5f8ed9aef3bb,
+            0x8aec23d680043bee, 0x25de7bb9480d5854,
+            0xada72ccc20054ae9, 0xaf561aa79a10ae6a,
+            0xd910f7ff28069da4, 0x1b2ba1518094da04,
+            0x87aa9aff79042286, 0x90fb44d2f05d0842,
+            0xa99541bf57452b28, 0x353a1607ac744a53,
+            0xd3fa922f2d1675f2, 0x42889b8997915ce8,
+            0x847c9b5d7c2e09b7, 0x69956135febada11,
+            0xa59bc234db398c25, 0x43fab9837e699095,
+            0xcf02b2c21207ef2e, 0x94f967e45e03f4bb,
+            0x8161afb94b44f57d, 0x1d1be0eebac278f5,
+            0xa1ba1ba79e1632dc, 0x6462d92a69731732,
+            0xca28a291859bbf93, 0x7d7b8f7503cfdcfe,
+            0xfcb2cb35e702af78, 0x5cda735244c3d43e,
+            0x9defbf01b061adab, 0x3a0888136afa64a7,
+            0xc56baec21c7a1916, 0x088aaa1845b8fdd0,
+            0xf6c69a72a3989f5b, 0x8aad549e57273d45,
+            0x9a3c2087a63f6399, 0x36ac54e2f678864b,
+            0xc0cb28a98fcf3c7f, 0x84576a1bb416a7dd,
+            0xf0fdf2d3f3c30b9f, 0x656d44a2a11c51d5,
+            0x969eb7c47859e743, 0x9f644ae5a4b1b325,
+            0xbc4665b596706114, 0x873d5d9f0dde1fee,
+            0xeb57ff22fc0c7959, 0xa90cb506d155a7ea,
+            0x9316ff75dd87cbd8, 0x09a7f12442d588f2,
+            0xb7dcbf5354e9bece, 0x0c11ed6d538aeb2f,
+            0xe5d3ef282a242e81, 0x8f1668c8a86da5fa,
+            0x8fa475791a569d10, 0xf96e017d694487bc,
+            0xb38d92d760ec4455, 0x37c981dcc395a9ac,
+            0xe070f78d3927556a, 0x85bbe253f47b1417,
+            0x8c469ab843b89562, 0x93956d7478ccec8e,
+            0xaf58416654a6babb, 0x387ac8d1970027b2,
+            0xdb2e51bfe9d0696a, 0x06997b05fcc0319e,
+            0x88fcf317f22241e2, 0x441fece3bdf81f03,
+            0xab3c2fddeeaad25a, 0xd527e81cad7626c3,
+            0xd60b3bd56a5586f1, 0x8a71e223d8d3b074,
+            0x85c7056562757456, 0xf6872d5667844e49,
+            0xa738c6bebb12d16c, 0xb428f8ac016561db,
+            0xd106f86e69d785c7, 0xe13336d701beba52,
+            0x82a45b450226b39c, 0xecc0024661173473,
+            0xa34d721642b06084, 0x27f002d7f95d0190,
+            0xcc20ce9bd35c78a5, 0x31ec038df7b441f4,
+            0xff290242c83396ce, 0x7e67047175a15271,
+            0x9f79a169bd203e41, 0x0f0062c6e984d386,
+            0xc75809c42c684dd1, 0x52c07b78a3e60868,
+            0xf92e0c3537826145, 0xa7709a56ccdf8a82,
+            0x9bbcc7a142b17ccb, 0x88a66076400bb691,
+            0xc2abf989935ddbfe, 0x6acff893d00ea435,
+            0xf356f7ebf83552fe, 0x0583f6b8c4124d43,
+            0x98165af37b2153de, 0xc3727a337a8b704a,
+            0xbe1bf1b059e9a8d6, 0x744f18c0592e4c5c,
+            0xeda2ee1c7064130c, 0x1162def06f79df73,
+            0x9485d4d1c63e8be7, 0x8addcb5645ac2ba8,
+            0xb9a74a0637ce2ee1, 0x6d953e2bd7173692,
+            0xe8111c87c5c1ba99, 0xc8fa8db6ccdd0437,
+            0x910ab1d4db9914a0, 0x1d9c9892400a22a2,
+            0xb54d5e4a127f59c8, 0x2503beb6d00cab4b,
+            0xe2a0b5dc971f303a, 0x2e44ae64840fd61d,
+            0x8da471a9de737e24, 0x5ceaecfed289e5d2,
+            0xb10d8e1456105dad, 0x7425a83e872c5f47,
+            0xdd50f1996b947518, 0xd12f124e28f77719,
+            0x8a5296ffe33cc92f, 0x82bd6b70d99aaa6f,
+            0xace73cbfdc0bfb7b, 0x636cc64d1001550b,
+            0xd8210befd30efa5a, 0x3c47f7e05401aa4e,
+            0x8714a775e3e95c78, 0x65acfaec34810a71,
+            0xa8d9d1535ce3b396, 0x7f1839a741a14d0d,
+            0xd31045a8341ca07c, 0x1ede48111209a050,
+            0x83ea2b892091e44d, 0x934aed0aab460432,
+            0xa4e4b66b68b65d60, 0xf81da84d5617853f,
+            0xce1de40642e3f4b9, 0x36251260ab9d668e,
+            0x80d2ae83e9ce78f3, 0xc1d72b7c6b426019,
+            0xa1075a24e4421730, 0xb24cf65b8612f81f,
+            0xc94930ae1d529cfc, 0xdee033f26797b627,
+            0xfb9b7cd9a4a7443c, 0x169840ef017da3b1,
+            0x9d412e0806e88aa5, 0x8e1f289560ee864e,
+            0xc491798a08a2ad4e, 0xf1a6f2bab92a27e2,
+            0xf5b5d7ec8acb58a2, 0xae10af696774b1db,
+            0x9991a6f3d6bf1765, 0xacca6da1e0a8ef29,
+            0xbff610b0cc6edd3f, 0x17fd090a58d32af3,
+            0xeff394dcff8a948e, 0xddfc4b4cef07f5b0,
+            0x95f83d0a1fb69cd9, 0x4abdaf101564f98e,
+            0xbb764c4ca7a4440f, 0x9d6d1ad41abe37f1,
+            0xea53df5fd18d5513, 0x84c86189216dc5ed,
+            0x92746b9be2f8552c, 0x32fd3cf5b4e49bb4,
+            0xb7118682dbb66a77, 0x3fbc8c33221dc2a1,
+            0xe4d5e82392a40515, 0x0fabaf3feaa5334a,
+            0x8f05b1163ba6832d, 0x29cb4d87f2a7400e,
+            0xb2c71d5bca9023f8, 0x743e20e9ef511012,
+            0xdf78e4b2bd342cf6, 0x914da9246b255416,
+            0x8bab8eefb6409c1a, 0x1ad089b6c2f7548e,
+            0xae9672aba3d0c320, 0xa184ac2473b529b1,
+            0xda3c0f568cc4f3e8, 0xc9e5d72d90a2741e,
+            0x8865899617fb1871, 0x7e2fa67c7a658892,
+            0xaa7eebfb9df9de8d, 0xddbb901b98feeab7,
+            0xd51ea6fa85785631, 0x552a74227f3ea565,
+            0x8533285c936b35de, 0xd53a88958f87275f,
+            0xa67ff273b8460356, 0x8a892abaf368f137,
+            0xd01fef10a657842c, 0x2d2b7569b0432d85,
+            0x8213f56a67f6b29b, 0x9c3b29620e29fc73,
+            0xa298f2c501f45f42, 0x8349f3ba91b47b8f,
+            0xcb3f2f7642717713, 0x241c70a936219a73,
+            0xfe0efb53d30dd4d7, 0xed238cd383aa0110,
+            0x9ec95d1463e8a506, 0xf4363804324a40aa,
+            0xc67bb4597ce2ce48, 0xb143c6053edcd0d5,
+            0xf81aa16fdc1b81da, 0xdd94b7868e94050a,
+            0x9b10a4e5e9913128, 0xca7cf2b4191c8326,
+            0xc1d4ce1f63f57d72, 0xfd1c2f611f63a3f0,
+            0xf24a01a73cf2dccf, 0xbc633b39673c8cec,
+            0x976e41088617ca01, 0xd5be0503e085d813,
+            0xbd49d14aa79dbc82, 0x4b2d8644d8a74e18,
+            0xec9c459d51852ba2, 0xddf8e7d60ed1219e,
+            0x93e1ab8252f33b45, 0xcabb90e5c942b503,
+            0xb8da1662e7b00a17, 0x3d6a751f3b936243,
+            0xe7109bfba19c0c9d, 0x0cc512670a783ad4,
+            0x906a617d450187e2, 0x27fb2b80668b24c5,
+            0xb484f9dc9641e9da, 0xb1f9f660802dedf6,
+            0xe1a63853bbd26451, 0x5e7873f8a0396973,
+            0x8d07e33455637eb2, 0xdb0b487b6423e1e8,
+            0xb049dc016abc5e5f, 0x91ce1a9a3d2cda62,
+            0xdc5c5301c56b75f7, 0x7641a140cc7810fb,
+            0x89b9b3e11b6329ba, 0xa9e904c87fcb0a9d,
+            0xac2820d9623bf429, 0x546345fa9fbdcd44,
+            0xd732290fbacaf133, 0xa97c177947ad4095,
+            0x867f59a9d4bed6c0, 0x49ed8eabcccc485d,
+            0xa81f301449ee8c70, 0x5c68f256bfff5a74,
+            0xd226fc195c6a2f8c, 0x73832eec6fff3111,
+            0x83585d8fd9c25db7, 0xc831fd53c5ff7eab,
+            0xa42e74f3d032f525, 0xba3e7ca8b77f5e55,
+            0xcd3a1230c43fb26f, 0x28ce1bd2e55f35eb,
+            0x80444b5e7aa7cf85, 0x7980d163cf5b81b3,
+            0xa0555e361951c366, 0xd7e105bcc332621f,
+            0xc86ab5c39fa63440, 0x8dd9472bf3fefaa7,
+            0xfa856334878fc150, 0xb14f98f6f0feb951,
+            0x9c935e00d4b9d8d2, 0x6ed1bf9a569f33d3,
+            0xc3b8358109e84f07, 0x0a862f80ec4700c8,
+            0xf4a642e14c6262c8, 0xcd27bb612758c0fa,
+            0x98e7e9cccfbd7dbd, 0x8038d51cb897789c,
+            0xbf21e44003acdd2c, 0xe0470a63e6bd56c3,
+            0xeeea5d5004981478, 0x1858ccfce06cac74,
+            0x95527a5202df0ccb, 0x0f37801e0c43ebc8,
+            0xbaa718e68396cffd, 0xd30560258f54e6ba,
+            0xe950df20247c83fd, 0x47c6b82ef32a2069,
+            0x91d28b7416cdd27e, 0x4cdc331d57fa5441,
+            0xb6472e511c81471d, 0xe0133fe4adf8e952,
+            0xe3d8f9e563a198e5, 0x58180fddd97723a6,
+            0x8e679c2f5e44ff8f, 0x570f09eaa7ea7648,
+        };
+
+        inline void mul_128(const uint64_t a, const uint64_t b, uint64_t& high, uint64_t& low)noexcept {
+#if defined(__SIZEOF_INT128__)
+            const unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+            high = static_cast<uint64_t>(r >> 64);
+            low = static_cast<uint64_t>(r);
+#else
+            const uint64_t p0 = (a & 0xFFFFFFFF) * (b & 0xFFFFFFFF);
+            const uint64_t p1 = (a & 0xFFFFFFFF) * (b >> 32);
+            const uint64_t p2 = (a >> 32) * (b & 0xFFFFFFFF);
+            const uint64_t p3 = (a >> 32) * (b >> 32);
+            const uint64_t mid = (p0 >> 32) + (p1 & 0xFFFFFFFF) + (p2 & 0xFFFFFFFF);
+            low = mid << 32 | (p0 & 0xFFFFFFFF);
+            high = p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+#endif // __SIZEOF_INT128__
+        }
+
+        // w * 10^q correctly rounded, w < 10^19. Small values take Clinger's exact path, the rest
+        // Eisel-Lemire, whose 128-bit product is always sufficient for an exact w.
+        inline double decimal_to_double(uint64_t w, const int64_t q)noexcept {
+            constexpr double exact_powers[] = {
+                1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+            };
+            if (w == 0 or q < -342)
+                return 0.0;
+            if (q > 308)
+                return std::numeric_limits<double>::infinity();
+            if (w <= uint64_t(1) << 53 and q >= -22 and q <= 22) {
+                const double x = static_cast<double>(w);
+                return q < 0 ? x / exact_powers[-q] : x * exact_powers[q];
+            }
+
+            const int lz = std::countl_zero(w);
+            w <<= lz;
+            const size_t index = 2 * static_cast<size_t>(q + 342);
+            uint64_t high, low;
+            mul_128(w, power_of_five_128[index], high, low);
+            if ((high & 0x1FF) == 0x1FF) {
+                uint64_t high2, low2;
+                mul_128(w, power_of_five_128[index + 1], high2, low2);
+                low += high2;
+                if (high2 > low)
+                    ++high;
+            }
+
+            const int upperbit = static_cast<int>(high >> 63);
+            const int shift = upperbit + 9;
+            uint64_t mantissa = high >> shift;
+            int64_t power2 = (((152170 + 65536) * q) >> 16) + 63 + upperbit - lz + 1023;
+            if (power2 <= 0) {  // subnormal
+                if (-power2 + 1 >= 64)
+                    return 0.0;
+                mantissa >>= -power2 + 1;
+                mantissa += mantissa & 1;
+                mantissa >>= 1;
+                power2 = mantissa < (uint64_t(1) << 52) ? 0 : 1;
+                return std::bit_cast<double>(uint64_t(power2) << 52 | (mantissa & ~(uint64_t(1) << 52)));
+            }
+            // exactly halfway between two doubles: round to even
+            if (low <= 1 and q >= -4 and q <= 23 and (mantissa & 3) == 1 and (mantissa << shift) == high)
+                mantissa &= ~uint64_t(1);
+            mantissa += mantissa & 1;
+            mantissa >>= 1;
+            if (mantissa >= (uint64_t(2) << 52)) {
+                mantissa = uint64_t(1) << 52;
+                ++power2;
+            }
+            if (power2 >= 0x7FF)
+                return std::numeric_limits<double>::infinity();
+            return std::bit_cast<double>(uint64_t(power2) << 52 | (mantissa & ~(uint64_t(1) << 52)));
+        }
+
+        // A number accumulated while it is scanned: the first 19 significant digits in mantissa, any
+        // further digits in tail, value = digits * 10^(exponent +- written_exponent).
+        struct decimal {
+            uint64_t mantissa = 0;
+            int64_t exponent = 0;
+            int64_t written_exponent = 0;
+            uint32_t digits = 0;
+            bool negative = false;
+            bool exponent_negative = false;
+            std::string tail;
+
+            void clear()noexcept {
+                mantissa = 0;
+                exponent = 0;
+                written_exponent = 0;
+                digits = 0;
+                negative = false;
+                exponent_negative = false;
+                tail.clear();
+            }
+
+            // Consumes the digits at iter, eight at a time while they fit the mantissa, returns the
+            // first non digit.
+            const char* append_digits(const char* iter, const char* const end, const bool fraction)noexcept {
+                const char* const first = iter;
+                while (digits <= 11 and end - iter >= 8) {
+                    uint64_t v;
+                    std::memcpy(&v, iter, 8);
+                    if constexpr (std::endian::native == std::endian::big)
+                        v = std::byteswap(v);
+                    const uint64_t bad = ((v & 0xF0F0F0F0F0F0F0F0) ^ 0x3030303030303030)
+                        | (((v + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) ^ 0x3030303030303030);
+                    if (bad)
+                        break;
+                    v -= 0x3030303030303030;
+                    // leading zeros are not significant
+                    digits += mantissa != 0 ? 8 : v ? 8 - (std::countr_zero(v) >> 3) : 0;
+                    v = v * 10 + (v >> 8);
+                    v = ((v & 0x000000FF000000FF) * (100 + (uint64_t(1000000) << 32))
+                        + ((v >> 16) & 0x000000FF000000FF) * (1 + (uint64_t(10000) << 32))) >> 32;
+                    mantissa = mantissa * 100000000 + (v & 0xFFFFFFFF);
+                    iter += 8;
+                }
+                while (iter != end and *iter >= '0' and *iter <= '9') {
+                    if (digits == 19) {
+                        const char* const run = simd::skip_digits(iter, end);
+                        tail.append(iter, run);
+                        iter = run;
+                        break;
+                    }
+                    if (mantissa != 0 or *iter != '0') {
+                        mantissa = mantissa * 10 + uint64_t(*iter - '0');
+                        ++digits;
+                    }
+                    ++iter;
+                }
+                if (fraction)
+                    exponent -= iter - first;
+                return iter;
+            }
+
+            // Reads the whole number at p from a complete buffer.
+            std::optional<parse_error_t> scan(const char* p, const char* const end, const char*& after)noexcept {
+                clear();
+                if (*p == '-') {
+                    negative = true;
+                    ++p;
+                    if (p == end)
+                        return parse_error_t::early_EOF;
+                    if (*p < '0' or *p > '9')
+                        return parse_error_t::unknown_number_character;
+                }
+                else if (*p < '0' or *p > '9')
+                    return parse_error_t::unknown_space;
+                p = *p == '0' ? p + 1 : append_digits(p, end, false);
+                if (p != end and *p == '.') {
+                    ++p;
+                    if (p == end)
+                        return parse_error_t::early_EOF;
+                    if (*p < '0' or *p > '9')
+                        return parse_error_t::unknown_number_character;
+                    p = append_digits(p, end, true);
+                }
+                if (p != end and (*p == 'e' or *p == 'E')) {
+                    ++p;
+                    if (p != end and (*p == '+' or *p == '-'))
+                        exponent_negative = *p++ == '-';
+                    if (p == end)
+                        return parse_error_t::early_EOF;
+                    if (*p < '0' or *p > '9')
+                        return parse_error_t::unknown_number_character;
+                    p = append_exponent(p, end);
+                }
+                after = p;
+                return {};
+            }
+
+            const char* append_exponent(const char* iter, const char* const end)noexcept {
+                while (iter != end and *iter >= '0' and *iter <= '9') {
+                    if (written_exponent < 100000000)
+                        written_exponent = written_exponent * 10 + (*iter - '0');
+                    ++iter;
+                }
+                return iter;
+            }
+
+            double get()noexcept {
+                const int64_t q = exponent + (exponent_negative ? -written_exponent : written_exponent);
+                double x;
+                if (tail.empty())
+                    x = decimal_to_double(mantissa, q);
+                else {
+                    // more than 19 significant digits, rare enough to hand the whole digit string to from_chars
+                    const int64_t magnitude = q + digits + static_cast<int64_t>(tail.size());
+                    char buf[24];
+                    tail.insert(0, buf, std::to_chars(buf, buf + sizeof(buf), mantissa).ptr - buf);
+                    tail.push_back('e');
+                    tail.append(buf, std::to_chars(buf, buf + sizeof(buf), q).ptr - buf);
+                    if (std::from_chars(tail.data(), tail.data() + tail.size(), x).ec != std::errc())
+                        x = magnitude > 0 ? std::numeric_limits<double>::infinity() : 0.0;
+                }
+                return negative ? -x : x;
+            }
+        };
+
+        // A skipped number or literal ends where parse_indexed would start the next token: at a structural
+        // character, a quote or a space. The grammar then checks what follows like after any other value.
+        constexpr bool ends_skipped_scalar(const char c)noexcept {
+            switch (c) {
+                case '{':
+                case '}':
+                case '[':
+                case ']':
+                case ':':
+                case ',':
+                case '\"':
+                case ' ':
+                case '\n':
+                case '\t':
+                case '\r':
+                case '\0':
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+#if defined(JSON_LEXER_COMPUTED_GOTO) and (defined(__GNUC__) or defined(__clang__))
+#define JSON_LEXER_THREADED 1
+        // threaded code: every handler jumps straight to the handler of the next state
+#define JSON_LEXER_STATE(s) case state_t::s: s##_label
+#define JSON_LEXER_DISPATCH() do { if (iter == end) goto finish_label; goto *dispatch[static_cast<size_t>(_state)]; } while (false)
+#else
+#define JSON_LEXER_STATE(s) case state_t::s
+#define JSON_LEXER_DISPATCH() continue
+#endif // JSON_LEXER_COMPUTED_GOTO
+
         template<Parser P>
         struct lexer {
             constexpr explicit lexer(P* p)noexcept :_parser{ p } {}
 
+            // Back to the start of a document, keeping the number buffer.
+            constexpr void reset()noexcept {
+                _state = state_t::normal;
+                _hex = 0;
+                bytes = 0;
+                unicode_high = 0;
+                unicode_low = 0;
+                _utf8_lower = 0x80;
+                _utf8_upper = 0xBF;
+                _number.clear();
+                _skip_depth = 0;
+                _skip_string = false;
+                _skip_escape = false;
+                _skip_scalar = false;
+            }
+
             constexpr std::optional<parse_error_t> operator()(const char* data, const size_t size)noexcept {
                 const char* iter = data;
                 const char* const end = iter + size;
                 std::optional<parse_error_t> err;
                 bytes = 0;
+                _string_begin = nullptr;
+#if defined(JSON_LEXER_THREADED)
+                static const void* const dispatch[] = {
+                    &&normal_label,
+                    &&after_quotation_mark_label,
+                    &&after_reverse_solidus_label,
+                    &&wait_4_hex_label,
+                    &&wait_3_hex_label,
+                    &&wait_2_hex_label,
+                    &&wait_1_hex_label,
+                    &&wait_low_reverse_solidus_label,
+                    &&wait_low_u_label,
+                    &&wait_low_4_hex_label,
+                    &&wait_low_3_hex_label,
+                    &&wait_low_2_hex_label,
+                    &&wait_low_1_hex_label,
+                    &&wait_3_utf8_bytes_label,
+                    &&wait_2_utf8_bytes_label,
+                    &&wait_1_utf8_bytes_label,
+                    &&after_optional_negative_label,
+                    &&after_zero_label,
+                    &&after_one_to_nine_label,
+                    &&after_point_label,
+                    &&parsing_digital_label,
+                    &&after_e_label,
+                    &&parsing_exponent_label,
+                    &&after_exponent_sign_label,
+                    &&fractional_part_label,
+                    &&f_label,
+                    &&fa_label,
+                    &&fal_label,
+                    &&fals_label,
+                    &&t_label,
+                    &&tr_label,
+                    &&tru_label,
+                    &&n_label,
+                    &&nu_label,
+                    &&nul_label,
+                    &&skip_label
+                };
+                static_assert(std::size(dispatch) == static_cast<size_t>(state_t::error));
+#endif // JSON_LEXER_THREADED
 
                 while (iter < end) {
                     switch (_state) {
-                        case state_t::normal:
+                        JSON_LEXER_STATE(normal):
                             {
                                 iter = skip_space(iter, end);
                                 if (iter == end) {
@@ -181,11 +1667,15 @@ namespace json {
                                     case '{':
                                         err = _parser->on_left_brace();
                                         if (err) {
-                                            bytes += iter - data + 1;
-                                            return err;
+                                            if (*err != parse_error_t::skip) {
+                                                bytes += iter - data + 1;
+                                                return err;
+                                            }
+                                            _begin_skip(1);
+                                            err.reset();
                                         }
                                         ++iter;
-                                        continue;
+                                        JSON_LEXER_DISPATCH();
                                     case '}':
                                         err = _parser->on_right_brace();
                                         if (err) {
@@ -193,15 +1683,19 @@ namespace json {
                                             return err;
                                         }
                                         ++iter;
-                                        continue;
+                                        JSON_LEXER_DISPATCH();
                                     case '[':
                                         err = _parser->on_left_square_bracket();
                                         if (err) {
-                                            bytes += iter - data + 1;
-                                            return err;
+                                            if (*err != parse_error_t::skip) {
+                                                bytes += iter - data + 1;
+                                                return err;
+                                            }
+                                            _begin_skip(1);
+                                            err.reset();
                                         }
                                         ++iter;
-                                        continue;
+                                        JSON_LEXER_DISPATCH();
                                     case ']':
                                         err = _parser->on_right_square_bracket();
                                         if (err) {
@@ -209,37 +1703,49 @@ namespace json {
                                             return err;
                                         }
                                         ++iter;
-                                        continue;
+                                        JSON_LEXER_DISPATCH();
                                     case 'f':
+                                        // whole literal in one compare, the f/fa/fal/fals states only run at the buffer end
+                                        if (end - iter >= 5 and match_word(iter + 1, "alse")) {
+                                            err = _parser->on_false();
+                                            if (err) {
+                                                bytes += iter - data + 5;
+                                                return err;
+                                            }
+                                            iter += 5;
+                                            JSON_LEXER_DISPATCH();
+                                        }
                                         _state = state_t::f;
                                         ++iter;
-                                        continue;
+                                        JSON_LEXER_DISPATCH();
                                     case 't':
+                                        if (end - iter >= 4 and match_word(iter, "true")) {
+                                            err = _parser->on_true();
+                                            if (err) {
+                                                bytes += iter - data + 4;
+                                                return err;
+                                            }
+                                            iter += 4;
+                                            JSON_LEXER_DISPATCH();
+                                        }
                                         _state = state_t::t;
                                         ++iter;
-                                        continue;
+                                        JSON_LEXER_DISPATCH();
                                     case 'n':
+                                        if (end - iter >= 4 and match_word(iter, "null")) {
+                                            err = _parser->on_null();
+                                            if (err) {
+                                                bytes += iter - data + 4;
+                                                return err;
+                                            }
+                                            iter += 4;
+                                            JSON_LEXER_DISPATCH();
+                                        }
                                         _state = state_t::n;
                                         ++iter;
-                                        continue;
+                                        JSON_LEXER_DISPATCH();
                                     case '-':
-                                        err = _parser->on_number_begin(c);
-                                        if (err) {
-                                            bytes += iter - data + 1;
-                                            return err;
-                                        }
-                                        _state = state_t::after_optional_negative;
-                                        ++iter;
-                                        continue;
                                     case '0':
-                                        err = _parser->on_number_begin(c);
-                                        if (err) {
-                                            bytes += iter - data + 1;
-                                            return err;
-                                        }
-                                        _state = state_t::after_zero;
-                                        ++iter;
-                                        continue;
                                     case '1':
                                     case '2':
                                     case '3':
@@ -249,14 +1755,23 @@ namespace json {
                                     case '7':
                                     case '8':
                                     case '9':
-                                        err = _parser->on_number_begin(c);
+                                        err = _parser->on_number_begin();
                                         if (err) {
                                             bytes += iter - data + 1;
                                             return err;
                                         }
-                                        _state = state_t::after_one_to_nine;
-                                        ++iter;
-                                        continue;
+                                        _number.clear();
+                                        if (c == '-') {
+                                            _number.negative = true;
+                                            _state = state_t::after_optional_negative;
+                                            ++iter;
+                                        }
+                                        else if (c == '0') {
+                                            _state = state_t::after_zero;
+                                            ++iter;
+                                        }
+                                        else _state = state_t::after_one_to_nine;
+                                        JSON_LEXER_DISPATCH();
                                     case '\"':
                                         err = _parser->on_string_begin();
                                         if (err) {
@@ -264,16 +1779,20 @@ namespace json {
                                             return err;
                                         }
                                         _state = state_t::after_quotation_mark;
-                                        ++iter;
-                                        continue;
+                                        _string_begin = ++iter;
+                                        JSON_LEXER_DISPATCH();
                                     case ':':
                                         err = _parser->on_colon();
                                         if (err) {
-                                            bytes += iter - data + 1;
-                                            return err;
+                                            if (*err != parse_error_t::skip) {
+                                                bytes += iter - data + 1;
+                                                return err;
+                                            }
+                                            _begin_skip(0);
+                                            err.reset();
                                         }
                                         ++iter;
-                                        continue;
+                                        JSON_LEXER_DISPATCH();
                                     case ',':
                                         err = _parser->on_comma();
                                         if (err) {
@@ -281,7 +1800,7 @@ namespace json {
                                             return err;
                                         }
                                         ++iter;
-                                        continue;
+                                        JSON_LEXER_DISPATCH();
                                     default:
                                         {
                                             bytes += iter - data + 1;
@@ -291,40 +1810,39 @@ namespace json {
                             }
 
                             // string
-                        case state_t::after_quotation_mark:
-                        case state_t::after_reverse_solidus:
-                        case state_t::wait_4_hex:
-                        case state_t::wait_3_hex:
-                        case state_t::wait_2_hex:
-                        case state_t::wait_1_hex:
-                        case state_t::wait_low_reverse_solidus:
-                        case state_t::wait_low_u:
-                        case state_t::wait_low_4_hex:
-                        case state_t::wait_low_3_hex:
-                        case state_t::wait_low_2_hex:
-                        case state_t::wait_low_1_hex:
-                        case state_t::wait_3_utf8_bytes:
-                        case state_t::wait_2_utf8_bytes:
-                        case state_t::wait_1_utf8_bytes:
+                        JSON_LEXER_STATE(after_quotation_mark):
+                        JSON_LEXER_STATE(after_reverse_solidus):
+                        JSON_LEXER_STATE(wait_4_hex):
+                        JSON_LEXER_STATE(wait_3_hex):
+                        JSON_LEXER_STATE(wait_2_hex):
+                        JSON_LEXER_STATE(wait_1_hex):
+                        JSON_LEXER_STATE(wait_low_reverse_solidus):
+                        JSON_LEXER_STATE(wait_low_u):
+                        JSON_LEXER_STATE(wait_low_4_hex):
+                        JSON_LEXER_STATE(wait_low_3_hex):
+                        JSON_LEXER_STATE(wait_low_2_hex):
+                        JSON_LEXER_STATE(wait_low_1_hex):
+                        JSON_LEXER_STATE(wait_3_utf8_bytes):
+                        JSON_LEXER_STATE(wait_2_utf8_bytes):
+                        JSON_LEXER_STATE(wait_1_utf8_bytes):
                             {
                                 iter = _parse_string(iter, end, err);
                                 if (err) {
                                     bytes += iter - data;
                                     return err;
                                 }
-                                continue;
+                                JSON_LEXER_DISPATCH();
                             }
 
                             // number
-                        case state_t::after_optional_negative:
+                        JSON_LEXER_STATE(after_optional_negative):
                             {
                                 const char c = *iter;
                                 switch (c) {
                                     case '0':
-                                        _parser->on_number(c);
                                         _state = state_t::after_zero;
                                         ++iter;
-                                        continue;
+                                        JSON_LEXER_DISPATCH();
                                     case '1':
                                     case '2':
                                     case '3':
@@ -334,293 +1852,172 @@ namespace json {
                                     case '7':
                                     case '8':
                                     case '9':
-                                        _parser->on_number(c);
-                                        _state = state_t::after_one_to_nine;
-                                        ++iter;
-                                        continue;
+                                        _state = state_t::parsing_digital;
+                                        JSON_LEXER_DISPATCH();
                                     default:
                                         bytes += iter - data + 1;
                                         return parse_error_t::unknown_number_character;
                                 }
                             }
-                        case state_t::after_point:
+                        JSON_LEXER_STATE(after_point):
                             {
-                                const char c = *iter;
-                                switch (c) {
-                                    case '0':
-                                    case '1':
-                                    case '2':
-                                    case '3':
-                                    case '4':
-                                    case '5':
-                                    case '6':
-                                    case '7':
-                                    case '8':
-                                    case '9':
-                                        _parser->on_number(c);
-                                        _state = state_t::fractional_part;
-                                        ++iter;
-                                        continue;
-                                    default:
-                                        bytes += iter - data + 1;
-                                        return parse_error_t::unknown_number_character;
+                                if (is_digit(*iter)) {
+                                    _state = state_t::fractional_part;
+                                    JSON_LEXER_DISPATCH();
                                 }
+                                bytes += iter - data + 1;
+                                return parse_error_t::unknown_number_character;
                             }
-                        case state_t::after_e:
+                        JSON_LEXER_STATE(after_e):
                             {
                                 const char c = *iter;
-                                switch (c) {
-                                    case '0':
-                                    case '1':
-                                    case '2':
-                                    case '3':
-                                    case '4':
-                                    case '5':
-                                    case '6':
-                                    case '7':
-                                    case '8':
-                                    case '9':
-                                        _parser->on_number(c);
-                                        _state = state_t::parsing_exponent;
-                                        ++iter;
-                                        continue;
-                                    case '+':
-                                    case '-':
-                                        _parser->on_number(c);
-                                        _state = state_t::after_exponent_sign;
-                                        ++iter;
-                                        continue;
-                                    default:
-                                        bytes += iter - data + 1;
-                                        return parse_error_t::unknown_number_character;
+                                if (is_digit(c)) {
+                                    _state = state_t::parsing_exponent;
+                                    JSON_LEXER_DISPATCH();
+                                }
+                                if (c == '+' or c == '-') {
+                                    _number.exponent_negative = c == '-';
+                                    _state = state_t::after_exponent_sign;
+                                    ++iter;
+                                    JSON_LEXER_DISPATCH();
                                 }
+                                bytes += iter - data + 1;
+                                return parse_error_t::unknown_number_character;
                             }
-                        case state_t::after_exponent_sign:
+                        JSON_LEXER_STATE(after_exponent_sign):
                             {
-                                const char c = *iter;
-                                switch (c) {
-                                    case '0':
-                                    case '1':
-                                    case '2':
-                                    case '3':
-                                    case '4':
-                                    case '5':
-                                    case '6':
-                                    case '7':
-                                    case '8':
-                                    case '9':
-                                        _parser->on_number(c);
-                                        _state = state_t::parsing_exponent;
-                                        ++iter;
-                                        continue;
-                                    default:
-                                        bytes += iter - data + 1;
-                                        return parse_error_t::unknown_number_character;
+                                if (is_digit(*iter)) {
+                                    _state = state_t::parsing_exponent;
+                                    JSON_LEXER_DISPATCH();
                                 }
+                                bytes += iter - data + 1;
+                                return parse_error_t::unknown_number_character;
                             }
 
                             // number acceptable state
-                        case state_t::after_zero:
+                        JSON_LEXER_STATE(after_zero):
                             {
                                 const char c = *iter;
                                 switch (c) {
                                     case '.':
-                                        _parser->on_number(c);
                                         _state = state_t::after_point;
                                         ++iter;
-                                        continue;
+                                        JSON_LEXER_DISPATCH();
                                     case 'e':
                                     case 'E':
-                                        _parser->on_number(c);
                                         _state = state_t::after_e;
                                         ++iter;
-                                        continue;
+                                        JSON_LEXER_DISPATCH();
                                     default:
-                                        err = _parser->on_number_end();
+                                        err = _end_number();
                                         if (err) {
                                             bytes += iter - data + 1;
                                             return err;
                                         }
                                         _state = state_t::normal;
-                                        continue;
+                                        JSON_LEXER_DISPATCH();
                                 }
                             }
-                        case state_t::after_one_to_nine:
+                        JSON_LEXER_STATE(after_one_to_nine):
+                        JSON_LEXER_STATE(parsing_digital):
                             {
+                                iter = _number.append_digits(iter, end, false);
+                                if (iter == end) {
+                                    _state = state_t::parsing_digital;
+                                    JSON_LEXER_DISPATCH();
+                                }
                                 const char c = *iter;
                                 switch (c) {
-                                    case '0':
-                                    case '1':
-                                    case '2':
-                                    case '3':
-                                    case '4':
-                                    case '5':
-                                    case '6':
-                                    case '7':
-                                    case '8':
-                                    case '9':
-                                        _parser->on_number(c);
-                                        _state = state_t::parsing_digital;
-                                        ++iter;
-                                        continue;
                                     case '.':
-                                        _parser->on_number(c);
                                         _state = state_t::after_point;
                                         ++iter;
-                                        continue;
+                                        JSON_LEXER_DISPATCH();
                                     case 'e':
                                     case 'E':
-                                        _parser->on_number(c);
                                         _state = state_t::after_e;
                                         ++iter;
-                                        continue;
+                                        JSON_LEXER_DISPATCH();
                                     default:
-                                        err = _parser->on_number_end();
+                                        err = _end_number();
                                         if (err) {
                                             bytes += iter - data + 1;
                                             return err;
                                         }
                                         _state = state_t::normal;
-                                        continue;
+                                        JSON_LEXER_DISPATCH();
                                 }
                             }
-                        case state_t::parsing_digital:
+                        JSON_LEXER_STATE(parsing_exponent):
                             {
-                                const char c = *iter;
-                                switch (c) {
-                                    case '.':
-                                        _parser->on_number(c);
-                                        _state = state_t::after_point;
-                                        ++iter;
-                                        continue;
-                                    case 'e':
-                                    case 'E':
-                                        _parser->on_number(c);
-                                        _state = state_t::after_e;
-                                        ++iter;
-                                        continue;
-                                    case '0':
-                                    case '1':
-                                    case '2':
-                                    case '3':
-                                    case '4':
-                                    case '5':
-                                    case '6':
-                                    case '7':
-                                    case '8':
-                                    case '9':
-                                        _parser->on_number(c);
-                                        ++iter;
-                                        continue;
-                                    default:
-                                        err = _parser->on_number_end();
-                                        if (err) {
-                                            bytes += iter - data + 1;
-                                            return err;
-                                        }
-                                        _state = state_t::normal;
-                                        continue;
+                                iter = _number.append_exponent(iter, end);
+                                if (iter == end)
+                                    JSON_LEXER_DISPATCH();
+                                err = _end_number();
+                                if (err) {
+                                    bytes += iter - data + 1;
+                                    return err;
                                 }
+                                _state = state_t::normal;
+                                JSON_LEXER_DISPATCH();
                             }
-                        case state_t::parsing_exponent:
+                        JSON_LEXER_STATE(fractional_part):
                             {
+                                iter = _number.append_digits(iter, end, true);
+                                if (iter == end)
+                                    JSON_LEXER_DISPATCH();
                                 const char c = *iter;
-                                switch (c) {
-                                    case '0':
-                                    case '1':
-                                    case '2':
-                                    case '3':
-                                    case '4':
-                                    case '5':
-                                    case '6':
-                                    case '7':
-                                    case '8':
-                                    case '9':
-                                        _parser->on_number(c);
-                                        ++iter;
-                                        continue;
-                                    default:
-                                        err = _parser->on_number_end();
-                                        if (err) {
-                                            bytes += iter - data + 1;
-                                            return err;
-                                        }
-                                        _state = state_t::normal;
-                                        continue;
+                                if (c == 'e' or c == 'E') {
+                                    _state = state_t::after_e;
+                                    ++iter;
+                                    JSON_LEXER_DISPATCH();
                                 }
-                            }
-                        case state_t::fractional_part:
-                            {
-                                const char c = *iter;
-                                switch (c) {
-                                    case '0':
-                                    case '1':
-                                    case '2':
-                                    case '3':
-                                    case '4':
-                                    case '5':
-                                    case '6':
-                                    case '7':
-                                    case '8':
-                                    case '9':
-                                        _parser->on_number(c);
-                                        ++iter;
-                                        continue;
-                                    case 'e':
-                                    case 'E':
-                                        _parser->on_number(c);
-                                        _state = state_t::after_e;
-                                        ++iter;
-                                        continue;
-                                    default:
-                                        err = _parser->on_number_end();
-                                        if (err) {
-                                            bytes += iter - data + 1;
-                                            return err;
-                                        }
-                                        _state = state_t::normal;
-                                        continue;
+                                err = _end_number();
+                                if (err) {
+                                    bytes += iter - data + 1;
+                                    return err;
                                 }
+                                _state = state_t::normal;
+                                JSON_LEXER_DISPATCH();
                             }
 
                             // false
-                        case state_t::f:
+                        JSON_LEXER_STATE(f):
                             {
                                 if (*iter == 'a') {
                                     _state = state_t::fa;
                                     ++iter;
-                                    continue;
+                                    JSON_LEXER_DISPATCH();
                                 }
                                 else {
                                     bytes += iter - data + 1;
                                     return parse_error_t::unknown_boolean_character;
                                 }
                             }
-                        case state_t::fa:
+                        JSON_LEXER_STATE(fa):
                             {
                                 if (*iter == 'l') {
                                     _state = state_t::fal;
                                     ++iter;
-                                    continue;
+                                    JSON_LEXER_DISPATCH();
                                 }
                                 else {
                                     bytes += iter - data + 1;
                                     return parse_error_t::unknown_boolean_character;
                                 }
                             }
-                        case state_t::fal:
+                        JSON_LEXER_STATE(fal):
                             {
                                 if (*iter == 's') {
                                     _state = state_t::fals;
                                     ++iter;
-                                    continue;
+                                    JSON_LEXER_DISPATCH();
                                 }
                                 else {
                                     bytes += iter - data + 1;
                                     return parse_error_t::unknown_boolean_character;
                                 }
                             }
-                        case state_t::fals:
+                        JSON_LEXER_STATE(fals):
                             {
                                 if (*iter == 'e') {
                                     err = _parser->on_false();
@@ -630,7 +2027,7 @@ namespace json {
                                     }
                                     _state = state_t::normal;
                                     ++iter;
-                                    continue;
+                                    JSON_LEXER_DISPATCH();
                                 }
                                 else {
                                     bytes += iter - data + 1;
@@ -639,31 +2036,31 @@ namespace json {
                             }
 
                             //true
-                        case state_t::t:
+                        JSON_LEXER_STATE(t):
                             {
                                 if (*iter == 'r') {
                                     _state = state_t::tr;
                                     ++iter;
-                                    continue;
+                                    JSON_LEXER_DISPATCH();
                                 }
                                 else {
                                     bytes += iter - data + 1;
                                     return parse_error_t::unknown_boolean_character;
                                 }
                             }
-                        case state_t::tr:
+                        JSON_LEXER_STATE(tr):
                             {
                                 if (*iter == 'u') {
                                     _state = state_t::tru;
                                     ++iter;
-                                    continue;
+                                    JSON_LEXER_DISPATCH();
                                 }
                                 else {
                                     bytes += iter - data + 1;
                                     return parse_error_t::unknown_boolean_character;
                                 }
                             }
-                        case state_t::tru:
+                        JSON_LEXER_STATE(tru):
                             {
                                 if (*iter == 'e') {
                                     err = _parser->on_true();
@@ -673,7 +2070,7 @@ namespace json {
                                     }
                                     _state = state_t::normal;
                                     ++iter;
-                                    continue;
+                                    JSON_LEXER_DISPATCH();
                                 }
                                 else {
                                     bytes += iter - data + 1;
@@ -682,31 +2079,31 @@ namespace json {
                             }
 
                             //null
-                        case state_t::n:
+                        JSON_LEXER_STATE(n):
                             {
                                 if (*iter == 'u') {
                                     _state = state_t::nu;
                                     ++iter;
-                                    continue;
+                                    JSON_LEXER_DISPATCH();
                                 }
                                 else {
                                     bytes += iter - data + 1;
                                     return parse_error_t::unknown_null_character;
                                 }
                             }
-                        case state_t::nu:
+                        JSON_LEXER_STATE(nu):
                             {
                                 if (*iter == 'l') {
                                     _state = state_t::nul;
                                     ++iter;
-                                    continue;
+                                    JSON_LEXER_DISPATCH();
                                 }
                                 else {
                                     bytes += iter - data + 1;
                                     return parse_error_t::unknown_null_character;
                                 }
                             }
-                        case state_t::nul:
+                        JSON_LEXER_STATE(nul):
                             {
                                 if (*iter == 'l') {
                                     err = _parser->on_null();
@@ -716,21 +2113,45 @@ namespace json {
                                     }
                                     _state = state_t::normal;
                                     ++iter;
-                                    continue;
+                                    JSON_LEXER_DISPATCH();
                                 }
                                 else {
                                     bytes += iter - data + 1;
                                     return parse_error_t::unknown_null_character;
                                 }
                             }
+
+                        JSON_LEXER_STATE(skip):
+                            {
+                                iter = _skip(iter, end, err);
+                                if (err) {
+                                    bytes += iter - data;
+                                    return err;
+                                }
+                                JSON_LEXER_DISPATCH();
+                            }
                         default:
                             std::unreachable();
                     }
                 }
+#if defined(JSON_LEXER_THREADED)
+                finish_label:
+#endif // JSON_LEXER_THREADED
                 bytes += size;
                 return {};
             }
 
+            static bool match_word(const char* const p, const char(&word)[5])noexcept {
+                uint32_t a, b;
+                std::memcpy(&a, p, 4);
+                std::memcpy(&b, word, 4);
+                return a == b;
+            }
+
+            static constexpr bool is_digit(const char c)noexcept {
+                return c >= '0' and c <= '9';
+            }
+
             static constexpr bool is_space(const char c)noexcept {
                 switch (c) {
                     case ' ':
@@ -745,6 +2166,13 @@ namespace json {
             }
 
             static constexpr const char* skip_space(const char* iter, const char* const end)noexcept {
+                // Most tokens are separated by zero or one space, only go wide for longer runs.
+                if (iter == end or !is_space(*iter))
+                    return iter;
+                ++iter;
+                if !consteval {
+                    iter = simd::skip_space(iter, end);
+                }
                 while (iter != end and is_space(*iter)) {
                     ++iter;
                 }
@@ -783,40 +2211,6 @@ namespace json {
                 }
             }
 
-            constexpr static std::string_view unicode_to_utf8(const uint32_t uc)noexcept {
-                static char buf[4];
-                size_t n = 0;
-
-                if (uc <= 0x7F) {
-                    // 单字节 UTF-8 编码
-                    n = 1;
-                    buf[0] = static_cast<char>(uc);
-                }
-                else if (uc <= 0x7FF) {
-                    // 双字节 UTF-8 编码
-                    n = 2;
-                    buf[0] = static_cast<char>(0xC0 | (uc >> 6));
-                    buf[1] = static_cast<char>(0x80 | (uc & 0x3F));
-                }
-                else if (uc <= 0xFFFF) {
-                    // 三字节 UTF-8 编码
-                    n = 3;
-                    buf[0] = static_cast<char>(0xE0 | (uc >> 12));
-                    buf[1] = static_cast<char>(0x80 | ((uc >> 6) & 0x3F));
-                    buf[2] = static_cast<char>(0x80 | (uc & 0x3F));
-                }
-                else if (uc <= 0x10FFFF) {
-                    // 四字节 UTF-8 编码
-                    n = 4;
-                    buf[0] = static_cast<char>(0xF0 | (uc >> 18));
-                    buf[1] = static_cast<char>(0x80 | ((uc >> 12) & 0x3F));
-                    buf[2] = static_cast<char>(0x80 | ((uc >> 6) & 0x3F));
-                    buf[3] = static_cast<char>(0x80 | (uc & 0x3F));
-                }
-
-                return { buf, n };
-            }
-
             P* _parser;
             enum struct state_t {
                 normal,
@@ -867,6 +2261,9 @@ namespace json {
                 nu,
                 nul,
 
+                // a value the builder skipped
+                skip,
+
                 error
             };
             state_t _state = state_t::normal;
@@ -874,8 +2271,97 @@ namespace json {
             size_t bytes = 0;
             uint32_t unicode_high = 0;
             uint32_t unicode_low = 0;
+            // accepted range of the next continuation byte
+            uint8_t _utf8_lower = 0x80;
+            uint8_t _utf8_upper = 0xBF;
+            decimal _number;
+            // content of the string opened in the current buffer, nullptr when it started in an earlier one
+            const char* _string_begin = nullptr;
+            // brackets still open in a skipped value, and where in it the last buffer ended
+            size_t _skip_depth = 0;
+            bool _skip_string = false;
+            bool _skip_escape = false;
+            bool _skip_scalar = false;
 
             private:
+            std::optional<parse_error_t> _end_number()noexcept {
+                return _parser->on_number(_number.get());
+            }
+
+            // depth 1 right after an opening bracket, 0 to skip a whole value after a colon
+            void _begin_skip(const size_t depth)noexcept {
+                _state = state_t::skip;
+                _skip_depth = depth;
+            }
+
+            const char* _skip(const char* iter, const char* const end, std::optional<parse_error_t>& err)noexcept {
+                while (iter < end) {
+                    if (_skip_string) {
+                        if (_skip_escape)
+                            _skip_escape = false;
+                        else {
+                            iter = simd::scan_string(iter, end);
+                            if (iter == end)
+                                break;
+                            if (*iter == '\\')
+                                _skip_escape = true;
+                            else if (*iter == '\"') {
+                                _skip_string = false;
+                                if (_skip_depth == 0)
+                                    return _end_skip(iter + 1, err);
+                            }
+                        }
+                        ++iter;
+                        continue;
+                    }
+                    const char c = *iter;
+                    if (_skip_scalar) {
+                        if (ends_skipped_scalar(c))
+                            return _end_skip(iter, err);
+                        ++iter;
+                        continue;
+                    }
+                    switch (c) {
+                        case '\"':
+                            _skip_string = true;
+                            break;
+                        case '{':
+                        case '[':
+                            ++_skip_depth;
+                            break;
+                        case '}':
+                        case ']':
+                            if (_skip_depth == 0) {
+                                err = parse_error_t{};
+                                return iter + 1;
+                            }
+                            if (--_skip_depth == 0)
+                                return _end_skip(iter + 1, err);
+                            break;
+                        case ',':
+                        case ':':
+                            if (_skip_depth == 0) {
+                                err = parse_error_t{};
+                                return iter + 1;
+                            }
+                            break;
+                        default:
+                            if (_skip_depth == 0 and !is_space(c))
+                                _skip_scalar = true;
+                            break;
+                    }
+                    ++iter;
+                }
+                return iter;
+            }
+
+            const char* _end_skip(const char* const iter, std::optional<parse_error_t>& err)noexcept {
+                _state = state_t::normal;
+                _skip_scalar = false;
+                err = _parser->on_skipped();
+                return iter;
+            }
+
             const char* _parse_string(const char* const data, const char* const end, std::optional<parse_error_t>& err)noexcept {
                 const char* iter = data;
                 const char* start = data;
@@ -883,51 +2369,82 @@ namespace json {
                     switch (_state) {
                         case state_t::after_quotation_mark:
                             {
+                                // plain ASCII runs are skipped in blocks and reported with one on_string
+                                iter = simd::scan_string(iter, end);
+                                if (iter == end)
+                                    continue;
                                 const char c = *iter;
-                                switch (std::countl_one((uint8_t)c)) {
-                                    case 0:
-                                        {   //ASCII
-                                            if (std::iscntrl(c)) {
-                                                err = parse_error_t::unknown_string_character;
-                                                return iter + 1;
-                                            }
-                                            switch (c) {
-                                                case '\"':
-                                                    if (start < iter) {
-                                                        _parser->on_string(start, iter - start);
-                                                    }
-                                                    _parser->on_string_end();
-                                                    _state = state_t::normal;
-                                                    return iter + 1;
-                                                case '\\':
+                                if (std::countl_one((uint8_t)c) == 0) {   //ASCII
+                                    if (std::iscntrl(c)) {
+                                        err = parse_error_t::unknown_string_character;
+                                        return iter + 1;
+                                    }
+                                    switch (c) {
+                                        case '\"':
+                                            if (start == _string_begin) // whole and escape free
+                                                err = _parser->on_string_end(std::string_view(start, iter - start));
+                                            else {
+                                                if (start < iter) {
                                                     _parser->on_string(start, iter - start);
-                                                    _state = state_t::after_reverse_solidus;
-                                                    ++iter;
-                                                    continue;
-                                                default:
-                                                    ++iter;
-                                                    continue;
+                                                }
+                                                err = _parser->on_string_end();
                                             }
-                                        }
-                                    case 1:
-                                        {
-                                            err = parse_error_t::unknown_string_character;
+                                            _state = state_t::normal;
                                             return iter + 1;
-                                        }
+                                        case '\\':
+                                            _parser->on_string(start, iter - start);
+                                            _state = state_t::after_reverse_solidus;
+                                            ++iter;
+                                            continue;
+                                        default:
+                                            ++iter;
+                                            continue;
+                                    }
+                                }
+                                // non ASCII: validate whole blocks at once, the scalar states below only
+                                // handle what is left of a sequence cut by a special character or the buffer end
+                                if (const char* p = simd::validate_utf8(iter, end); p != iter) {
+                                    if (p == nullptr) {
+                                        err = parse_error_t::unknown_utf8_bytes;
+                                        return iter + 1;
+                                    }
+                                    iter = p;
+                                    continue;
+                                }
+                                const auto lead = (uint8_t)c;
+                                _utf8_lower = 0x80;
+                                _utf8_upper = 0xBF;
+                                switch (std::countl_one(lead)) {
                                     case 2:
+                                        if (lead < 0xC2) {  // overlong
+                                            err = parse_error_t::unknown_utf8_bytes;
+                                            return iter + 1;
+                                        }
                                         _state = state_t::wait_1_utf8_bytes;
                                         ++iter;
                                         continue;
                                     case 3:
+                                        if (lead == 0xE0)       // overlong
+                                            _utf8_lower = 0xA0;
+                                        else if (lead == 0xED)  // surrogate
+                                            _utf8_upper = 0x9F;
                                         _state = state_t::wait_2_utf8_bytes;
                                         ++iter;
                                         continue;
                                     case 4:
+                                        if (lead == 0xF0)       // overlong
+                                            _utf8_lower = 0x90;
+                                        else if (lead == 0xF4)  // > U+10FFFF
+                                            _utf8_upper = 0x8F;
+                                        else if (lead > 0xF4) {
+                                            err = parse_error_t::unknown_utf8_bytes;
+                                            return iter + 1;
+                                        }
                                         _state = state_t::wait_3_utf8_bytes;
                                         ++iter;
                                         continue;
                                     default:
-                                        err = parse_error_t::unknown_string_character;
+                                        err = parse_error_t::unknown_utf8_bytes;
                                         return iter + 1;
                                 }
                             }
@@ -968,6 +2485,38 @@ namespace json {
                                         start = ++iter;
                                         continue;
                                     case 'u':
+                                        // whole escape in the buffer: decode it here, otherwise digit by digit
+                                        if (end - iter > 4) {
+                                            if (const auto high = decode_hex4(iter + 1); high) {
+                                                iter += 5;
+                                                uint32_t uc = *high;
+                                                if (uc >= 0xDC00 && uc <= 0xDFFF) {
+                                                    // a low surrogate without the high one
+                                                    err = parse_error_t::unknown_hex_character;
+                                                    return iter;
+                                                }
+                                                if (uc >= 0xD800 && uc <= 0xDBFF) {
+                                                    const auto low = end - iter > 5 and iter[0] == '\\' and iter[1] == 'u' ?
+                                                        decode_hex4(iter + 2) : std::nullopt;
+                                                    if (!low) {
+                                                        unicode_high = uc;
+                                                        _state = state_t::wait_low_reverse_solidus;
+                                                        continue;
+                                                    }
+                                                    if (*low < 0xDC00 or *low > 0xDFFF) {
+                                                        err = parse_error_t::unknown_hex_character;
+                                                        return iter + 6;
+                                                    }
+                                                    uc = 0x10000 + ((uc - 0xD800) << 10) + (*low - 0xDC00);
+                                                    iter += 6;
+                                                }
+                                                char buf[4];
+                                                _parser->on_string(buf, encode_utf8(uc, buf));
+                                                _state = state_t::after_quotation_mark;
+                                                start = iter;
+                                                continue;
+                                            }
+                                        }
                                         _state = state_t::wait_4_hex;
                                         ++iter;
                                         continue;
@@ -1023,13 +2572,17 @@ namespace json {
                                 const char c = *iter;
                                 if (auto op = hex_to_int(c); op) {
                                     unicode_high |= *op;
+                                    if (unicode_high >= 0xDC00 && unicode_high <= 0xDFFF) {
+                                        err = parse_error_t::unknown_hex_character;
+                                        return iter + 1;
+                                    }
                                     if (unicode_high >= 0xD800 && unicode_high <= 0xDBFF) {
                                         _state = state_t::wait_low_reverse_solidus;
                                         ++iter;
                                         continue;
                                     }
-                                    const auto utf8 = unicode_to_utf8(unicode_high);
-                                    _parser->on_string(utf8.data(), utf8.size());
+                                    char buf[4];
+                                    _parser->on_string(buf, encode_utf8(unicode_high, buf));
                                     unicode_high = 0;
                                     _state = state_t::after_quotation_mark;
                                     start = ++iter;
@@ -1113,9 +2666,13 @@ namespace json {
                                 const char c = *iter;
                                 if (auto op = hex_to_int(c); op) {
                                     unicode_low |= *op;
+                                    if (unicode_low < 0xDC00 or unicode_low > 0xDFFF) {
+                                        err = parse_error_t::unknown_hex_character;
+                                        return iter + 1;
+                                    }
                                     const uint32_t uc = 0x10000 + ((unicode_high - 0xD800) << 10) + (unicode_low - 0xDC00);
-                                    const auto utf8 = unicode_to_utf8(uc);
-                                    _parser->on_string(utf8.data(), utf8.size());
+                                    char buf[4];
+                                    _parser->on_string(buf, encode_utf8(uc, buf));
                                     unicode_high = unicode_low = 0;
                                     _state = state_t::after_quotation_mark;
                                     start = ++iter;
@@ -1127,17 +2684,22 @@ namespace json {
                                 }
                             }
                         case state_t::wait_3_utf8_bytes:
-                            _state = state_t::wait_2_utf8_bytes;
-                            start = ++iter;
-                            continue;
                         case state_t::wait_2_utf8_bytes:
-                            _state = state_t::wait_1_utf8_bytes;
-                            start = ++iter;
-                            continue;
                         case state_t::wait_1_utf8_bytes:
-                            _state = state_t::after_quotation_mark;
-                            start = ++iter;
-                            continue;
+                            {
+                                const auto c = (uint8_t)*iter;
+                                if (c < _utf8_lower or c > _utf8_upper) {
+                                    err = parse_error_t::unknown_utf8_bytes;
+                                    return iter + 1;
+                                }
+                                _utf8_lower = 0x80;
+                                _utf8_upper = 0xBF;
+                                _state = _state == state_t::wait_3_utf8_bytes ? state_t::wait_2_utf8_bytes
+                                    : _state == state_t::wait_2_utf8_bytes ? state_t::wait_1_utf8_bytes
+                                    : state_t::after_quotation_mark;
+                                ++iter;
+                                continue;
+                            }
                         default:
                             std::unreachable();
                     }
@@ -1155,575 +2717,1008 @@ namespace json {
             }
         };
 
+#undef JSON_LEXER_STATE
+#undef JSON_LEXER_DISPATCH
+
         template<Builder B>
         struct parser {
-            constexpr explicit parser(B* b) :builder{ b } {
-                _stack.emplace_back(json_parser{ {}, state_t{}, this });
+            constexpr explicit parser(B* b, const size_t capacity = 32) :builder{ b } {
+                _stack.reserve(capacity);
+                _stack.push_back(state_t::document);
+            }
+
+            // Back to the start of a document, keeping the capacity of the stack and string buffer.
+            constexpr void reset()noexcept {
+                _stack.clear();
+                _stack.push_back(state_t::document);
+                _str.clear();
+                _skip_value = false;
             }
 
             constexpr std::optional<parse_error_t> on_null()noexcept {
                 assert(!_stack.empty());
-                return std::visit([ ](auto& p) {
-                    return p.on_null();
-                    }, _stack.back());
+                switch (_stack.back()) {
+                    case state_t::array_first:
+                    case state_t::element:
+                        _stack.back() = state_t::array_next;
+                        return builder->on_null();
+                    case state_t::value:
+                        _stack.pop_back();
+                        return builder->on_null();
+                    default:
+                        return parse_error_t{};
+                }
             }
 
             constexpr std::optional<parse_error_t> on_true()noexcept {
                 assert(!_stack.empty());
-                return std::visit([ ](auto& p) {
-                    return p.on_true();
-                    }, _stack.back());
+                switch (_stack.back()) {
+                    case state_t::array_first:
+                    case state_t::element:
+                        _stack.back() = state_t::array_next;
+                        return builder->on_bool(true);
+                    case state_t::value:
+                        _stack.pop_back();
+                        return builder->on_bool(true);
+                    default:
+                        return parse_error_t{};
+                }
             }
 
             constexpr std::optional<parse_error_t> on_false()noexcept {
                 assert(!_stack.empty());
-                return std::visit([ ](auto& p) {
-                    return p.on_false();
-                    }, _stack.back());
+                switch (_stack.back()) {
+                    case state_t::array_first:
+                    case state_t::element:
+                        _stack.back() = state_t::array_next;
+                        return builder->on_bool(false);
+                    case state_t::value:
+                        _stack.pop_back();
+                        return builder->on_bool(false);
+                    default:
+                        return parse_error_t{};
+                }
             }
 
             constexpr std::optional<parse_error_t> on_string(const char* data, size_t size)noexcept {
                 assert(!_stack.empty());
-                return std::visit([=](auto& p) {
-                    return p.on_string(data, size);
-                    }, _stack.back());
+                switch (_stack.back()) {
+                    case state_t::key:
+                    case state_t::value:
+                        _str.append(data, size);
+                        return {};
+                    default:
+                        return parse_error_t{};
+                }
             }
 
             constexpr std::optional<parse_error_t> on_string_begin()noexcept {
                 assert(!_stack.empty());
-                return std::visit([ ](auto& p) {
-                    return p.on_string_begin();
-                    }, _stack.back());
+                switch (_stack.back()) {
+                    case state_t::object_first:
+                        _stack.back() = state_t::object_next;
+                        _stack.push_back(state_t::key);
+                        return {};
+                    case state_t::array_first:
+                    case state_t::element:
+                        _stack.back() = state_t::array_next;
+                        _stack.push_back(state_t::value);
+                        return {};
+                    case state_t::key:
+                    case state_t::value:
+                        return {};
+                    default:
+                        return parse_error_t{};
+                }
             }
 
             constexpr std::optional<parse_error_t> on_string_end()noexcept {
-                assert(!_stack.empty());
-                return std::visit([ ](auto& p) {
-                    return p.on_string_end();
-                    }, _stack.back());
+                const auto err = _string_end<false>(_str);
+                _str.clear();
+                return err;
+            }
+
+            // The whole string in one escape free piece, it skips the buffer.
+            constexpr std::optional<parse_error_t> on_string_end(const std::string_view str)noexcept {
+                return _string_end<false>(str);
+            }
+
+            // Same, str lies in a complete input that outlives the parse.
+            constexpr std::optional<parse_error_t> on_borrowed_string_end(const std::string_view str)noexcept {
+                return _string_end<BorrowingBuilder<B>>(str);
             }
 
             constexpr std::optional<parse_error_t> on_comma()noexcept {
                 assert(!_stack.empty());
-                return std::visit([ ](auto& p) {
-                    return p.on_comma();
-                    }, _stack.back());
+                switch (_stack.back()) {
+                    case state_t::object_next:
+                        _stack.push_back(state_t::key);
+                        return {};
+                    case state_t::array_next:
+                        _stack.back() = state_t::element;
+                        return {};
+                    default:
+                        return parse_error_t{};
+                }
             }
 
+            // Returns skip when the builder dropped the key, the driver then jumps over the value.
             constexpr std::optional<parse_error_t> on_colon()noexcept {
                 assert(!_stack.empty());
-                return std::visit([ ](auto& p) {
-                    return p.on_colon();
-                    }, _stack.back());
+                if (_stack.back() == state_t::colon) {
+                    _stack.back() = state_t::value;
+                    if (_skip_value) {
+                        _skip_value = false;
+                        return parse_error_t::skip;
+                    }
+                    return {};
+                }
+                return parse_error_t{};
             }
 
-            constexpr std::optional<parse_error_t> on_number(const char c)noexcept {
+            // The driver is past a value it skipped, either after a colon or from its opening bracket.
+            constexpr std::optional<parse_error_t> on_skipped()noexcept {
                 assert(!_stack.empty());
-                return std::visit([=](auto& p) {
-                    return p.on_number(c);
-                    }, _stack.back());
+                _stack.pop_back();
+                if (_stack.empty()) {
+                    builder->on_document_end();
+                    return parse_error_t::happy_ending;
+                }
+                return {};
             }
 
-            constexpr std::optional<parse_error_t> on_number_begin(const char c)noexcept {
+            constexpr std::optional<parse_error_t> on_number(const double x)noexcept {
                 assert(!_stack.empty());
-                return std::visit([=](auto& p) {
-                    return p.on_number_begin(c);
-                    }, _stack.back());
+                if (_stack.back() == state_t::value) {
+                    _stack.pop_back();
+                    return builder->on_number(x);
+                }
+                return parse_error_t{};
             }
 
-            constexpr std::optional<parse_error_t> on_number_end()noexcept {
+            constexpr std::optional<parse_error_t> on_number_begin()noexcept {
                 assert(!_stack.empty());
-                return std::visit([ ](auto& p) {
-                    return p.on_number_end();
-                    }, _stack.back());
+                switch (_stack.back()) {
+                    case state_t::array_first:
+                    case state_t::element:
+                        _stack.back() = state_t::array_next;
+                        _stack.push_back(state_t::value);
+                        return {};
+                    case state_t::value:
+                        return {};
+                    default:
+                        return parse_error_t{};
+                }
             }
 
             constexpr std::optional<parse_error_t> on_left_square_bracket()noexcept {
                 assert(!_stack.empty());
-                return std::visit([ ](auto& p) {
-                    return p.on_left_square_bracket();
-                    }, _stack.back());
+                switch (_stack.back()) {
+                    case state_t::document:
+                        if (auto err = builder->on_document_begin(); err)
+                            return err;
+                        [[fallthrough]];
+                    case state_t::value:
+                        _stack.back() = state_t::array_first;
+                        return builder->on_array_begin();
+                    case state_t::array_first:
+                    case state_t::element:
+                        _stack.back() = state_t::array_next;
+                        _stack.push_back(state_t::array_first);
+                        return builder->on_array_begin();
+                    default:
+                        return parse_error_t{};
+                }
             }
 
             constexpr std::optional<parse_error_t> on_right_square_bracket()noexcept {
                 assert(!_stack.empty());
-                return std::visit([ ](auto& p) {
-                    return p.on_right_square_bracket();
-                    }, _stack.back());
+                switch (_stack.back()) {
+                    case state_t::array_first:
+                    case state_t::array_next:
+                        {
+                            auto err = builder->on_array_end();
+                            _stack.pop_back();
+                            if (_stack.empty()) {
+                                builder->on_document_end();
+                                return parse_error_t::happy_ending;
+                            }
+                            return err;
+                        }
+                    default:
+                        return parse_error_t{};
+                }
             }
 
             constexpr std::optional<parse_error_t> on_left_brace()noexcept {
                 assert(!_stack.empty());
-                return std::visit([ ](auto& p) {
-                    return p.on_left_brace();
-                    }, _stack.back());
+                switch (_stack.back()) {
+                    case state_t::document:
+                        if (auto err = builder->on_document_begin(); err)
+                            return err;
+                        [[fallthrough]];
+                    case state_t::value:
+                        _stack.back() = state_t::object_first;
+                        return builder->on_object_begin();
+                    case state_t::array_first:
+                    case state_t::element:
+                        _stack.back() = state_t::array_next;
+                        _stack.push_back(state_t::object_first);
+                        return builder->on_object_begin();
+                    default:
+                        return parse_error_t{};
+                }
             }
 
             constexpr std::optional<parse_error_t> on_right_brace()noexcept {
                 assert(!_stack.empty());
-                return std::visit([ ](auto& p) {
-                    return p.on_right_brace();
-                    }, _stack.back());
+                switch (_stack.back()) {
+                    case state_t::object_first:
+                    case state_t::object_next:
+                        {
+                            auto err = builder->on_object_end();
+                            if (err)
+                                return err;
+                            _stack.pop_back();
+                            if (_stack.empty()) {
+                                builder->on_document_end();
+                                return parse_error_t::happy_ending;
+                            }
+                            return {};
+                        }
+                    default:
+                        return parse_error_t{};
+                }
+            }
+
+            // The string being read, fused_parser decodes strings with escapes straight into it.
+            constexpr std::string& string_buffer()noexcept {
+                return _str;
             }
 
             B* builder;
 
             private:
-            enum struct state_t {
-                start,
-
-                parsing_object,
-
-                parsing_A,
-                parsing_A_after_B,
-
-                parsing_B,
-
-                parsing_pair,
-                parsing_pair_after_string,
-
-                parsing_array,
-
-                parsing_C,
-
-                parsing_elements,
-
-                parsing_D,
-
-                parsing_value,
-            };
-
-            struct parse_functor_base {
-                constexpr std::optional<parse_error_t> on_null()noexcept {
-                    return parse_error_t{};
-                }
-
-                constexpr std::optional<parse_error_t> on_true()noexcept {
-                    return parse_error_t{};
-                }
-
-                constexpr std::optional<parse_error_t> on_false()noexcept {
-                    return parse_error_t{};
-                }
-
-                constexpr std::optional<parse_error_t> on_string(const char* data, size_t size)noexcept {
-                    return parse_error_t{};
-                }
-
-                constexpr std::optional<parse_error_t> on_string_begin()noexcept {
-                    return parse_error_t{};
-                }
-
-                constexpr std::optional<parse_error_t> on_string_end()noexcept {
-                    return parse_error_t{};
-                }
-
-                constexpr std::optional<parse_error_t> on_comma()noexcept {
-                    return parse_error_t{};
-                }
-
-                constexpr std::optional<parse_error_t> on_colon()noexcept {
-                    return parse_error_t{};
-                }
-
-                constexpr std::optional<parse_error_t> on_number(const char c)noexcept {
-                    return parse_error_t{};
-                }
-
-                constexpr std::optional<parse_error_t> on_number_begin(const char c)noexcept {
-                    return parse_error_t{};
-                }
-
-                constexpr std::optional<parse_error_t> on_number_end()noexcept {
-                    return parse_error_t{};
-                }
-
-                constexpr std::optional<parse_error_t> on_left_square_bracket()noexcept {
-                    return parse_error_t{};
-                }
-
-                constexpr std::optional<parse_error_t> on_right_square_bracket()noexcept {
-                    return parse_error_t{};
-                }
-
-                constexpr std::optional<parse_error_t> on_left_brace()noexcept {
-                    return parse_error_t{};
-                }
-
-                constexpr std::optional<parse_error_t> on_right_brace()noexcept {
-                    return parse_error_t{};
-                }
-            };
-
-            struct json_parser : parse_functor_base {
-                constexpr std::optional<parse_error_t> on_left_brace()noexcept {
-                    auto p = parent;
-                    auto err = p->builder->on_document_begin();
-                    if (err)
-                        return err;
-                    p->_stack.back() = object_parser{ {}, state_t::parsing_object, p };
-                    return std::get<object_parser>(p->_stack.back()).on_left_brace();
+            template<bool Borrowed>
+            constexpr std::optional<parse_error_t> _string_end(const std::string_view str)noexcept {
+                assert(!_stack.empty());
+                switch (_stack.back()) {
+                    case state_t::key:
+                        {
+                            _stack.back() = state_t::colon;
+                            std::optional<parse_error_t> err;
+                            if constexpr (Borrowed)
+                                err = builder->on_borrowed_key(str);
+                            else
+                                err = builder->on_key(str);
+                            if (err == parse_error_t::skip) {
+                                _skip_value = true;
+                                return {};
+                            }
+                            return err;
+                        }
+                    case state_t::value:
+                        _stack.pop_back();
+                        if constexpr (Borrowed)
+                            return builder->on_borrowed_string(str);
+                        else
+                            return builder->on_string(str);
+                    default:
+                        return parse_error_t{};
                 }
+            }
 
-                constexpr std::optional<parse_error_t> on_left_square_bracket()noexcept {
-                    auto p = parent;
-                    auto err = p->builder->on_document_begin();
-                    if (err)
-                        return err;
-                    p->_stack.back() = array_parser{ {}, state_t::parsing_array, p };
-                    return std::get<array_parser>(p->_stack.back()).on_left_square_bracket();
-                }
+            // What the innermost open production expects next, LL(1) over
+            //   document -> object | array
+            //   object   -> '{' '}' | '{' key ':' value (',' key ':' value)* '}'
+            //   array    -> '[' ']' | '[' value (',' value)* ']'
+            enum struct state_t : uint8_t {
+                document,
 
-                state_t state;
-                parser* parent;
-            };
+                object_first,   // key or '}'
+                object_next,    // ',' or '}'
+                key,
+                colon,
 
-            struct object_parser : parse_functor_base {
-                constexpr std::optional<parse_error_t> on_left_brace()noexcept {
-                    auto err = parent->builder->on_object_begin();
-                    auto p = parent;
-                    p->_stack.back() = A_parser{ {}, state_t::parsing_A, p };
-                    return err;
-                }
+                value,
 
-                state_t state;
-                parser* parent;
+                array_first,    // value or ']'
+                element,        // value
+                array_next,     // ',' or ']'
             };
 
-            struct A_parser : parse_functor_base {
-                constexpr std::optional<parse_error_t> on_right_brace()noexcept {
-                    if (state == state_t::parsing_A or state == state_t::parsing_A_after_B) {
-                        auto p = parent;
-                        auto err = p->builder->on_object_end();
-                        if (err)
-                            return err;
-                        p->_stack.pop_back();
-                        if (p->_stack.empty()) {
-                            p->builder->on_document_end();
-                            return parse_error_t::happy_ending;
-                        }
-                        return {};
-                    }
-                    return parse_error_t{};
-                }
+            std::vector<state_t> _stack;
+            // the key or string value being read
+            std::string _str;
+            // the builder dropped the last key
+            bool _skip_value = false;
+        };
 
-                constexpr std::optional<parse_error_t> on_string_begin()noexcept {
-                    if (state == state_t::parsing_A) {
-                        state = state_t::parsing_A_after_B;
-                        auto p = parent;
-                        p->_stack.emplace_back(B_parser{ {}, state_t::parsing_B, p });
-                        p->_stack.emplace_back(pair_parser{ {}, state_t::parsing_pair, p });
-                        return std::get<pair_parser>(p->_stack.back()).on_string_begin();
-                    }
-                    return parse_error_t{};
+        // Stage 1 of parse_indexed: offsets of every structural character, opening quote and first
+        // character of a number or literal outside of strings, in input order.
+        inline void index_structurals(const char* const data, const size_t size, std::vector<uint32_t>& index)noexcept {
+            // a quarter of the input covers typical JSON, denser input grows the index per block
+            // instead of sizing it for one entry per byte
+            index.clear();
+            index.reserve(size / 4 + 64);
+            uint64_t prev_escaped = 0;
+            uint64_t prev_in_string = 0;
+            uint64_t prev_scalar = 0;
+            for (size_t base = 0; base < size; base += 64) {
+                simd::block_masks m;
+                if (size - base >= 64)
+                    m = simd::classify(data + base);
+                else {
+                    char buf[64];
+                    std::memset(buf, ' ', sizeof(buf));
+                    std::memcpy(buf, data + base, size - base);
+                    m = simd::classify(buf);
                 }
-
-                state_t state;
-                parser* parent;
-            };
-
-            struct B_parser : parse_functor_base {
-                constexpr std::optional<parse_error_t> on_right_brace()noexcept {
-                    if (state == state_t::parsing_B) {
-                        auto p = parent;
-                        p->_stack.pop_back();
-                        return p->on_right_brace();
-                    }
-                    return parse_error_t{};
+                const uint64_t quote = m.quote & ~simd::find_escaped(m.backslash, prev_escaped);
+                const uint64_t in_string = simd::prefix_xor(quote) ^ prev_in_string;
+                prev_in_string = static_cast<uint64_t>(static_cast<int64_t>(in_string) >> 63);
+                // string content and closing quotes, the opening quote is kept as a scalar start
+                const uint64_t string_tail = in_string ^ quote;
+                const uint64_t scalar = ~(m.op | m.space);
+                const uint64_t nonquote_scalar = scalar & ~quote;
+                const uint64_t follows_scalar = nonquote_scalar << 1 | prev_scalar;
+                prev_scalar = nonquote_scalar >> 63;
+                uint64_t structurals = (m.op | (scalar & ~follows_scalar)) & ~string_tail;
+                const size_t n = index.size();
+                index.resize(n + std::popcount(structurals));
+                uint32_t* out = index.data() + n;
+                while (structurals) {
+                    *out++ = static_cast<uint32_t>(base + std::countr_zero(structurals));
+                    structurals &= structurals - 1;
                 }
+            }
+        }
 
-                constexpr std::optional<parse_error_t> on_comma()noexcept {
-                    auto p = parent;
-                    p->_stack.emplace_back(pair_parser{ {}, state_t::parsing_pair,p });
-                    return {};
-                }
+        template<size_t N>
+        std::optional<parse_error_t> match_literal(const char* const p, const char* const end, const char(&word)[N], const parse_error_t error)noexcept {
+            if (end - p >= static_cast<ptrdiff_t>(N - 1) and std::memcmp(p, word, N - 1) == 0)
+                return {};
+            for (size_t i = 0; i < N - 1; ++i) {
+                if (p + i == end)
+                    return parse_error_t::early_EOF;
+                if (p[i] != word[i])
+                    return error;
+            }
+            return {};
+        }
 
-                state_t state;
-                parser* parent;
-            };
+        // The error of the first bad byte in the n byte \uXXXX or \uXXXX\uXXXX escape at q, in the order the
+        // lexer meets them.
+        inline parse_error_t unicode_escape_error(const char* const q, const char* const end, const size_t n)noexcept {
+            for (size_t i = 2; i < n; ++i) {
+                if (q + i == end)
+                    return parse_error_t::early_EOF;
+                const char c = q[i];
+                const char lower = c | 0x20;
+                const bool ok = i == 6 ? c == '\\' : i == 7 ? c == 'u'
+                    : (c >= '0' and c <= '9') or (lower >= 'a' and lower <= 'f');
+                if (!ok)
+                    return parse_error_t::unknown_hex_character;
+            }
+            return parse_error_t::unknown_hex_character;
+        }
 
-            struct pair_parser : parse_functor_base {
-                constexpr std::optional<parse_error_t> on_string_begin()noexcept {
-                    if (state == state_t::parsing_pair) {
+        // q points to the backslash, iter is moved past the escape sequence.
+        inline std::optional<parse_error_t> decode_escape(const char* const q, const char* const end, const char*& iter, std::string& out)noexcept {
+            if (end - q < 2)
+                return parse_error_t::early_EOF;
+            switch (q[1]) {
+                case '\"':
+                case '\\':
+                case '/':
+                    out.push_back(q[1]);
+                    break;
+                case 'b':
+                    out.push_back('\b');
+                    break;
+                case 'f':
+                    out.push_back('\f');
+                    break;
+                case 'n':
+                    out.push_back('\n');
+                    break;
+                case 'r':
+                    out.push_back('\r');
+                    break;
+                case 't':
+                    out.push_back('\t');
+                    break;
+                case 'u':
+                    {
+                        const auto high = end - q >= 6 ? decode_hex4(q + 2) : std::nullopt;
+                        if (!high)
+                            return unicode_escape_error(q, end, 6);
+                        uint32_t uc = *high;
+                        iter = q + 6;
+                        if (uc >= 0xDC00 and uc <= 0xDFFF)
+                            return parse_error_t::unknown_hex_character;
+                        if (uc >= 0xD800 and uc <= 0xDBFF) {
+                            const auto low = end - q >= 12 and q[6] == '\\' and q[7] == 'u' ? decode_hex4(q + 8) : std::nullopt;
+                            if (!low)
+                                return unicode_escape_error(q, end, 12);
+                            if (*low < 0xDC00 or *low > 0xDFFF)
+                                return parse_error_t::unknown_hex_character;
+                            uc = 0x10000 + ((uc - 0xD800) << 10) + (*low - 0xDC00);
+                            iter = q + 12;
+                        }
+                        char buf[4];
+                        out.append(buf, encode_utf8(uc, buf));
                         return {};
                     }
-                    return parse_error_t{};
-                }
+                default:
+                    return parse_error_t::unknown_ESC;
+            }
+            iter = q + 2;
+            return {};
+        }
 
-                constexpr std::optional<parse_error_t> on_string(const char* data, size_t size)noexcept {
-                    key.append(data, size);
-                    return {};
+        // Skips string content up to the closing quote or the next backslash, checking it on the way.
+        inline const char* skip_plain_string(const char* iter, const char* const end, std::optional<parse_error_t>& err)noexcept {
+            while (true) {
+                iter = simd::scan_string(iter, end);
+                if (iter == end) {
+                    err = parse_error_t::early_EOF;
+                    return iter;
                 }
-
-                constexpr std::optional<parse_error_t> on_string_end()noexcept {
-                    std::string str;
-                    str.swap(key);
-                    state = state_t::parsing_pair_after_string;
-                    return parent->builder->on_key(std::move(str));
+                const auto c = static_cast<uint8_t>(*iter);
+                if (c == '\"' or c == '\\')
+                    return iter;
+                if (c < 0x80) {
+                    err = parse_error_t::unknown_string_character;
+                    return iter;
                 }
-
-                constexpr std::optional<parse_error_t> on_colon()noexcept {
-                    if (state == state_t::parsing_pair_after_string) {
-                        auto p = parent;
-                        p->_stack.back() = value_parser{ {}, state_t::parsing_value, p };
-                        return {};
+                if (const char* v = simd::validate_utf8(iter, end); v != iter) {
+                    if (v == nullptr) {
+                        err = parse_error_t::unknown_utf8_bytes;
+                        return iter;
                     }
-                    return parse_error_t{};
-                }
-
-                state_t state;
-                parser* parent;
-                std::string key;
-            };
-
-            struct value_parser : parse_functor_base {
-                constexpr std::optional<parse_error_t> on_left_brace()noexcept {
-                    auto p = parent;
-                    p->_stack.back() = object_parser{ {}, state_t::parsing_object, p };
-                    return std::get<object_parser>(p->_stack.back()).on_left_brace();
-                }
-
-                constexpr std::optional<parse_error_t> on_left_square_bracket()noexcept {
-                    auto p = parent;
-                    p->_stack.back() = array_parser{ {}, state_t::parsing_array, p };
-                    return std::get<array_parser>(p->_stack.back()).on_left_square_bracket();
-                }
-
-                constexpr std::optional<parse_error_t> on_number(const char c)noexcept {
-                    str.push_back(c);
-                    return {};
+                    iter = v;
+                    continue;
                 }
-
-                constexpr std::optional<parse_error_t> on_number_begin(const char c)noexcept {
-                    str.push_back(c);
-                    return {};
-                }
-
-                constexpr std::optional<parse_error_t> on_number_end()noexcept {
-                    std::string num;
-                    str.swap(num);
-                    auto err = parent->builder->on_number(std::move(num));
-                    parent->_stack.pop_back();
-                    return err;
-                }
-
-                constexpr std::optional<parse_error_t> on_true()noexcept {
-                    auto err = parent->builder->on_bool(true);
-                    parent->_stack.pop_back();
-                    return err;
+                const int n = utf8_sequence_length(iter, end);
+                if (n <= 0) {
+                    err = n == 0 ? parse_error_t::unknown_utf8_bytes : parse_error_t::early_EOF;
+                    return iter;
                 }
+                iter += n;
+            }
+        }
 
-                constexpr std::optional<parse_error_t> on_false()noexcept {
-                    auto err = parent->builder->on_bool(false);
-                    parent->_stack.pop_back();
+        // iter points into the content of a string, the decoded rest is appended to out.
+        inline std::optional<parse_error_t> decode_string(const char* iter, const char* const end, std::string& out, const char*& after)noexcept {
+            while (true) {
+                std::optional<parse_error_t> err;
+                const char* q = skip_plain_string(iter, end, err);
+                if (err)
                     return err;
-                }
-
-                constexpr std::optional<parse_error_t> on_string(const char* data, size_t size)noexcept {
-                    str.append(data, size);
-                    return {};
-                }
-
-                constexpr std::optional<parse_error_t> on_string_begin()noexcept {
+                out.append(iter, q);
+                if (*q == '\"') {
+                    after = q + 1;
                     return {};
                 }
-
-                constexpr std::optional<parse_error_t> on_string_end()noexcept {
-                    std::string s;
-                    s.swap(str);
-                    auto err = parent->builder->on_string(std::move(s));
-                    parent->_stack.pop_back();
-                    return err;
-                }
-
-                constexpr std::optional<parse_error_t> on_null()noexcept {
-                    auto err = parent->builder->on_null();
-                    parent->_stack.pop_back();
+                err = decode_escape(q, end, iter, out);
+                if (err)
                     return err;
-                }
+            }
+        }
 
-                state_t state;
-                parser* parent;
-                std::string str;
-            };
+        // Skips a string after its opening quote, returns the position after the closing one or nullptr.
+        inline const char* skip_quoted(const char* iter, const char* const end)noexcept {
+            while (true) {
+                iter = simd::scan_string(iter, end);
+                if (iter == end)
+                    return nullptr;
+                if (*iter == '\"')
+                    return iter + 1;
+                if (*iter == '\\' and ++iter == end)
+                    return nullptr;
+                ++iter;
+            }
+        }
 
-            struct array_parser : parse_functor_base {
-                constexpr std::optional<parse_error_t> on_left_square_bracket()noexcept {
-                    auto p = parent;
-                    auto err = p->builder->on_array_begin();
-                    p->_stack.back() = C_parser{ {}, state_t::parsing_C, p };
-                    return err;
+        // Skips the rest of a container after its opening bracket, returns the position after the matching
+        // close or nullptr. Only brackets and strings are tracked.
+        inline const char* skip_container(const char* iter, const char* const end)noexcept {
+            for (size_t depth = 1; iter < end;) {
+                switch (*iter++) {
+                    case '\"':
+                        iter = skip_quoted(iter, end);
+                        if (iter == nullptr)
+                            return nullptr;
+                        break;
+                    case '{':
+                    case '[':
+                        ++depth;
+                        break;
+                    case '}':
+                    case ']':
+                        if (--depth == 0)
+                            return iter;
+                        break;
+                    default:
+                        break;
                 }
+            }
+            return nullptr;
+        }
 
-                state_t state;
-                parser* parent;
-            };
-
-            struct C_parser : parse_functor_base {
-                constexpr std::optional<parse_error_t> on_null()noexcept {
-                    if (state == state_t::parsing_C) {
-                        auto p = parent;
-                        p->_stack.emplace_back(elements_parser{ {}, state_t::parsing_elements, p });
-                        return std::get<elements_parser>(p->_stack.back()).on_null();
+        // Skips the value starting at iter without validating it.
+        inline const char* skip_value(const char* iter, const char* const end, std::optional<parse_error_t>& err)noexcept {
+            const char* q = nullptr;
+            switch (*iter) {
+                case '{':
+                case '[':
+                    q = skip_container(iter + 1, end);
+                    break;
+                case '\"':
+                    q = skip_quoted(iter + 1, end);
+                    break;
+                case '}':
+                case ']':
+                case ':':
+                case ',':
+                    err = parse_error_t{};
+                    return iter;
+                default:
+                    for (; iter != end; ++iter) {
+                        if (ends_skipped_scalar(*iter))
+                            return iter;
                     }
-                    return parse_error_t{};
-                }
+                    return iter;
+            }
+            if (q == nullptr) {
+                err = parse_error_t::early_EOF;
+                return end;
+            }
+            return q;
+        }
 
-                constexpr std::optional<parse_error_t> on_true()noexcept {
-                    if (state == state_t::parsing_C) {
-                        auto p = parent;
-                        p->_stack.emplace_back(elements_parser{ {}, state_t::parsing_elements, p });
-                        return std::get<elements_parser>(p->_stack.back()).on_true();
-                    }
-                    return parse_error_t{};
-                }
+        // Stage 2 of parse_indexed: walks the structural index and drives the builder with the same
+        // events and grammar as parser.
+        template<Builder B>
+        struct indexed_parser {
+            constexpr indexed_parser(B* b, const char* data, size_t size)noexcept :builder{ b }, _data{ data }, _end{ data + size } {}
+
+            // Returns nothing once the document is complete, check consumed() for extra content.
+            std::optional<parse_error_t> operator()(const uint32_t* first, const uint32_t* const last)noexcept {
+                _idx = first;
+                if (first == last)
+                    return parse_error_t::early_EOF;
+                const char* p = _data + *first;
+                if (*p != '{' and *p != '[')
+                    return _unexpected(p);
+                auto err = builder->on_document_begin();
+                if (err)
+                    return err;
 
-                constexpr std::optional<parse_error_t> on_false()noexcept {
-                    if (state == state_t::parsing_C) {
-                        auto p = parent;
-                        p->_stack.emplace_back(elements_parser{ {}, state_t::parsing_elements, p });
-                        return std::get<elements_parser>(p->_stack.back()).on_false();
+                state_t state = state_t::value;
+                bool skip = false;
+                for (; _idx != last; ++_idx) {
+                    p = _data + *_idx;
+                    switch (state) {
+                        case state_t::array_first:
+                            if (*p == ']') {
+                                err = _close(state);
+                                if (err)
+                                    return err;
+                                if (_stack.empty())
+                                    return _finish();
+                                continue;
+                            }
+                            [[fallthrough]];
+                        case state_t::value:
+                            if (skip) {
+                                skip = false;
+                                if (*p == '}' or *p == ']' or *p == ':' or *p == ',')
+                                    return _unexpected(p);
+                                if ((*p == '{' or *p == '[') and !_skip_container(last))
+                                    return parse_error_t::early_EOF;
+                                if (*p != '{' and *p != '[' and *p != '\"') {
+                                    // the index runs a scalar into a quote right after it, parse stops there
+                                    const char* q = p;
+                                    while (q != _end and !ends_skipped_scalar(*q))
+                                        ++q;
+                                    err = _check_next(q, last);
+                                    if (err)
+                                        return err;
+                                }
+                                state = state_t::after_value;
+                                continue;
+                            }
+                            switch (*p) {
+                                case '{':
+                                    err = builder->on_object_begin();
+                                    if (err == parse_error_t::skip) {
+                                        if (!_skip_container(last))
+                                            return parse_error_t::early_EOF;
+                                        if (_stack.empty())
+                                            return _finish();
+                                        state = state_t::after_value;
+                                        continue;
+                                    }
+                                    if (err)
+                                        return err;
+                                    _stack.push_back('{');
+                                    state = state_t::object_first;
+                                    continue;
+                                case '[':
+                                    err = builder->on_array_begin();
+                                    if (err == parse_error_t::skip) {
+                                        if (!_skip_container(last))
+                                            return parse_error_t::early_EOF;
+                                        if (_stack.empty())
+                                            return _finish();
+                                        state = state_t::after_value;
+                                        continue;
+                                    }
+                                    if (err)
+                                        return err;
+                                    _stack.push_back('[');
+                                    state = state_t::array_first;
+                                    continue;
+                                case '}':
+                                case ']':
+                                case ':':
+                                case ',':
+                                    return _unexpected(p);
+                                default:
+                                    err = _scalar(p, last);
+                                    if (err)
+                                        return err;
+                                    state = state_t::after_value;
+                                    continue;
+                            }
+                        case state_t::object_first:
+                            if (*p == '}') {
+                                err = _close(state);
+                                if (err)
+                                    return err;
+                                if (_stack.empty())
+                                    return _finish();
+                                continue;
+                            }
+                            [[fallthrough]];
+                        case state_t::key:
+                            {
+                                if (*p != '\"')
+                                    return _unexpected(p);
+                                err = _string<true>(p, last);
+                                if (err == parse_error_t::skip)
+                                    skip = true;
+                                else if (err)
+                                    return err;
+                                state = state_t::colon;
+                                continue;
+                            }
+                        case state_t::colon:
+                            if (*p != ':')
+                                return _unexpected(p);
+                            state = state_t::value;
+                            continue;
+                        case state_t::after_value:
+                            if (*p == ',') {
+                                state = _stack.back() == '{' ? state_t::key : state_t::value;
+                                continue;
+                            }
+                            if (*p == (_stack.back() == '{' ? '}' : ']')) {
+                                err = _close(state);
+                                if (err)
+                                    return err;
+                                if (_stack.empty())
+                                    return _finish();
+                                continue;
+                            }
+                            return _unexpected(p);
+                        default:
+                            std::unreachable();
                     }
-                    return parse_error_t{};
                 }
+                return parse_error_t::early_EOF;
+            }
 
-                constexpr std::optional<parse_error_t> on_string_begin()noexcept {
-                    if (state == state_t::parsing_C) {
-                        auto p = parent;
-                        p->_stack.emplace_back(elements_parser{ {}, state_t::parsing_elements, p });
-                        return std::get<elements_parser>(p->_stack.back()).on_string_begin();
-                    }
-                    return parse_error_t{};
-                }
+            // Index entries used up to the end of the document.
+            const uint32_t* consumed()const noexcept {
+                return _idx;
+            }
 
-                constexpr std::optional<parse_error_t> on_number_begin(const char c)noexcept {
-                    if (state == state_t::parsing_C) {
-                        auto p = parent;
-                        p->_stack.emplace_back(elements_parser{ {}, state_t::parsing_elements, p });
-                        return std::get<elements_parser>(p->_stack.back()).on_number_begin(c);
-                    }
-                    return parse_error_t{};
-                }
+            B* builder;
 
-                constexpr std::optional<parse_error_t> on_left_square_bracket()noexcept {
-                    if (state == state_t::parsing_C) {
-                        auto p = parent;
-                        p->_stack.emplace_back(elements_parser{ {}, state_t::parsing_elements, p });
-                        return std::get<elements_parser>(p->_stack.back()).on_left_square_bracket();
-                    }
-                    return parse_error_t{};
-                }
+            private:
+            enum struct state_t : uint8_t {
+                value,
+                object_first,
+                key,
+                colon,
+                array_first,
+                after_value
+            };
 
-                constexpr std::optional<parse_error_t> on_right_square_bracket()noexcept {
-                    auto p = parent;
-                    auto err = p->builder->on_array_end();
-                    p->_stack.pop_back();
-                    if (p->_stack.empty()) {
-                        p->builder->on_document_end();
-                        return parse_error_t::happy_ending;
-                    }
-                    return err;
-                }
+            std::optional<parse_error_t> _close(state_t& state)noexcept {
+                const auto err = _stack.back() == '{' ? builder->on_object_end() : builder->on_array_end();
+                _stack.pop_back();
+                state = state_t::after_value;
+                return err;
+            }
 
-                constexpr std::optional<parse_error_t> on_left_brace()noexcept {
-                    if (state == state_t::parsing_C) {
-                        auto p = parent;
-                        p->_stack.emplace_back(elements_parser{ {}, state_t::parsing_elements, p });
-                        return std::get<elements_parser>(p->_stack.back()).on_left_brace();
+            // Moves _idx to the bracket closing the one it is on. The index holds no string content, so
+            // counting brackets is enough.
+            bool _skip_container(const uint32_t* const last)noexcept {
+                size_t depth = 0;
+                for (; _idx != last; ++_idx) {
+                    switch (_data[*_idx]) {
+                        case '{':
+                        case '[':
+                            ++depth;
+                            break;
+                        case '}':
+                        case ']':
+                            if (--depth == 0)
+                                return true;
+                            break;
+                        default:
+                            break;
                     }
-                    return parse_error_t{};
                 }
+                return false;
+            }
 
-                state_t state;
-                parser* parent;
-            };
-
-            struct elements_parser : parse_functor_base {
-                constexpr std::optional<parse_error_t> on_null()noexcept {
-                    auto p = parent;
-                    p->_stack.back() = D_parser{ {}, state_t::parsing_D, p };
-                    p->_stack.emplace_back(value_parser{ {}, state_t::parsing_value, p });
-                    return std::get<value_parser>(p->_stack.back()).on_null();
-                }
+            std::optional<parse_error_t> _finish()noexcept {
+                builder->on_document_end();
+                ++_idx;
+                return {};
+            }
 
-                constexpr std::optional<parse_error_t> on_true()noexcept {
-                    auto p = parent;
-                    p->_stack.back() = D_parser{ {}, state_t::parsing_D, p };
-                    p->_stack.emplace_back(value_parser{ {}, state_t::parsing_value, p });
-                    return std::get<value_parser>(p->_stack.back()).on_true();
+            // The error parse reports for a token the grammar does not expect at p: literals are read
+            // before the grammar sees them, so a malformed one reports its own error.
+            std::optional<parse_error_t> _unexpected(const char* const p)const noexcept {
+                switch (*p) {
+                    case 't':
+                        return match_literal(p, _end, "true", parse_error_t::unknown_boolean_character).value_or(parse_error_t{});
+                    case 'f':
+                        return match_literal(p, _end, "false", parse_error_t::unknown_boolean_character).value_or(parse_error_t{});
+                    case 'n':
+                        return match_literal(p, _end, "null", parse_error_t::unknown_null_character).value_or(parse_error_t{});
+                    case '{':
+                    case '}':
+                    case '[':
+                    case ']':
+                    case ':':
+                    case ',':
+                    case '\"':
+                    case '-':
+                        return parse_error_t{};
+                    default:
+                        if (*p >= '0' and *p <= '9')
+                            return parse_error_t{};
+                        return parse_error_t::unknown_space;
                 }
+            }
 
-                constexpr std::optional<parse_error_t> on_false()noexcept {
-                    auto p = parent;
-                    p->_stack.back() = D_parser{ {}, state_t::parsing_D, p };
-                    p->_stack.emplace_back(value_parser{ {}, state_t::parsing_value, p });
-                    return std::get<value_parser>(p->_stack.back()).on_false();
-                }
+            // A scalar must end where the next index entry starts, apart from spaces.
+            std::optional<parse_error_t> _check_next(const char* const after, const uint32_t* const last)const noexcept {
+                const char* next = lexer<parser<B>>::skip_space(after, _end);
+                if (next == (_idx + 1 == last ? _end : _data + _idx[1]))
+                    return {};
+                return _unexpected(next);
+            }
 
-                constexpr std::optional<parse_error_t> on_string_begin()noexcept {
-                    auto p = parent;
-                    p->_stack.back() = D_parser{ {}, state_t::parsing_D, p };
-                    p->_stack.emplace_back(value_parser{ {}, state_t::parsing_value, p });
-                    return std::get<value_parser>(p->_stack.back()).on_string_begin();
+            // Escape free strings are passed as views of the input, the others are decoded into _str.
+            template<bool Key>
+            std::optional<parse_error_t> _string(const char* const p, const uint32_t* const last)noexcept {
+                std::optional<parse_error_t> err;
+                const char* q = skip_plain_string(p + 1, _end, err);
+                if (err)
+                    return err;
+                const bool borrowed = *q == '\"';
+                std::string_view str(p + 1, q - p - 1);
+                const char* after = q + 1;
+                if (!borrowed) {
+                    _str.assign(p + 1, q);
+                    err = decode_string(q, _end, _str, after);
+                    if (err)
+                        return err;
+                    str = _str;
                 }
-
-                constexpr std::optional<parse_error_t> on_number_begin(const char c)noexcept {
-                    auto p = parent;
-                    p->_stack.back() = D_parser{ {}, state_t::parsing_D, p };
-                    p->_stack.emplace_back(value_parser{ {}, state_t::parsing_value, p });
-                    return std::get<value_parser>(p->_stack.back()).on_number_begin(c);
+                err = _check_next(after, last);
+                if (err)
+                    return err;
+                if constexpr (BorrowingBuilder<B>) {
+                    if (borrowed)
+                        return Key ? builder->on_borrowed_key(str) : builder->on_borrowed_string(str);
                 }
+                return Key ? builder->on_key(str) : builder->on_string(str);
+            }
 
-                constexpr std::optional<parse_error_t> on_left_square_bracket()noexcept {
-                    auto p = parent;
-                    p->_stack.back() = D_parser{ {}, state_t::parsing_D, p };
-                    p->_stack.emplace_back(value_parser{ {}, state_t::parsing_value, p });
-                    return std::get<value_parser>(p->_stack.back()).on_left_square_bracket();
+            std::optional<parse_error_t> _scalar(const char* const p, const uint32_t* const last)noexcept {
+                const char* after = nullptr;
+                std::optional<parse_error_t> err;
+                switch (*p) {
+                    case '\"':
+                        return _string<false>(p, last);
+                    case 't':
+                        err = match_literal(p, _end, "true", parse_error_t::unknown_boolean_character);
+                        if (!err)
+                            err = _check_next(p + 4, last);
+                        if (err)
+                            return err;
+                        return builder->on_bool(true);
+                    case 'f':
+                        err = match_literal(p, _end, "false", parse_error_t::unknown_boolean_character);
+                        if (!err)
+                            err = _check_next(p + 5, last);
+                        if (err)
+                            return err;
+                        return builder->on_bool(false);
+                    case 'n':
+                        err = match_literal(p, _end, "null", parse_error_t::unknown_null_character);
+                        if (!err)
+                            err = _check_next(p + 4, last);
+                        if (err)
+                            return err;
+                        return builder->on_null();
+                    default:
+                        err = _decimal.scan(p, _end, after);
+                        if (!err)
+                            err = _check_next(after, last);
+                        if (err)
+                            return err;
+                        return builder->on_number(_decimal.get());
                 }
+            }
 
-                constexpr std::optional<parse_error_t> on_left_brace()noexcept {
-                    auto p = parent;
-                    p->_stack.back() = D_parser{ {}, state_t::parsing_D, p };
-                    p->_stack.emplace_back(value_parser{ {}, state_t::parsing_value, p });
-                    return std::get<value_parser>(p->_stack.back()).on_left_brace();
-                }
+            const char* _data;
+            const char* _end;
+            const uint32_t* _idx = nullptr;
+            std::vector<char> _stack;
+            std::string _str;
+            decimal _decimal;
+        };
 
-                state_t state;
-                parser* parent;
-            };
+        // p is just past the colon of a dropped key or the opening bracket of a dropped container, it is
+        // moved past the dropped value without reading it.
+        template<Builder B>
+        std::optional<parse_error_t> skip_dropped(const char*& p, const char* const end)noexcept {
+            std::optional<parse_error_t> err;
+            if (p[-1] == ':') {
+                p = lexer<parser<B>>::skip_space(p, end);
+                if (p == end)
+                    return parse_error_t::early_EOF;
+                p = skip_value(p, end, err);
+            }
+            else {
+                p = skip_container(p, end);
+                if (p == nullptr)
+                    return parse_error_t::early_EOF;
+            }
+            return err;
+        }
 
-            struct D_parser : parse_functor_base {
-                constexpr std::optional<parse_error_t> on_right_square_bracket()noexcept {
-                    auto p = parent;
-                    p->_stack.pop_back();
-                    assert(!p->_stack.empty());
-                    return p->on_right_square_bracket();
-                }
+        // Single pass parser for complete buffers: tokens are read whole and fed to the grammar of parser,
+        // which calls the builder directly. Accepts, rejects and reports errors like lexer + parser.
+        template<Builder B>
+        struct fused_parser {
+            constexpr explicit fused_parser(parser<B>* p)noexcept :_parser{ *p } {}
 
-                constexpr std::optional<parse_error_t> on_comma()noexcept {
-                    auto p = parent;
-                    p->_stack.back() = elements_parser{ {}, state_t::parsing_elements, p };
-                    return {};
+            // Returns nothing once the document is complete, check consumed() for extra content.
+            std::optional<parse_error_t> operator()(const char* const data, const size_t size)noexcept {
+                const char* p = data;
+                const char* const end = data + size;
+                std::optional<parse_error_t> err;
+                while (true) {
+                    p = lexer<parser<B>>::skip_space(p, end);
+                    if (p == end)
+                        return parse_error_t::early_EOF;
+                    switch (*p) {
+                        case '{':
+                            err = _parser.on_left_brace();
+                            ++p;
+                            break;
+                        case '}':
+                            err = _parser.on_right_brace();
+                            ++p;
+                            break;
+                        case '[':
+                            err = _parser.on_left_square_bracket();
+                            ++p;
+                            break;
+                        case ']':
+                            err = _parser.on_right_square_bracket();
+                            ++p;
+                            break;
+                        case ':':
+                            err = _parser.on_colon();
+                            ++p;
+                            break;
+                        case ',':
+                            err = _parser.on_comma();
+                            ++p;
+                            break;
+                        case '\"':
+                            {
+                                err = _parser.on_string_begin();
+                                if (err)
+                                    break;
+                                const char* q = skip_plain_string(p + 1, end, err);
+                                if (err)
+                                    break;
+                                if (*q == '\"') {
+                                    err = _parser.on_borrowed_string_end(std::string_view(p + 1, q - p - 1));
+                                    p = q + 1;
+                                    break;
+                                }
+                                auto& buffer = _parser.string_buffer();
+                                buffer.append(p + 1, q);
+                                err = decode_string(q, end, buffer, p);
+                                if (!err)
+                                    err = _parser.on_string_end();
+                                break;
+                            }
+                        case 't':
+                            err = match_literal(p, end, "true", parse_error_t::unknown_boolean_character);
+                            if (!err)
+                                err = _parser.on_true();
+                            p += 4;
+                            break;
+                        case 'f':
+                            err = match_literal(p, end, "false", parse_error_t::unknown_boolean_character);
+                            if (!err)
+                                err = _parser.on_false();
+                            p += 5;
+                            break;
+                        case 'n':
+                            err = match_literal(p, end, "null", parse_error_t::unknown_null_character);
+                            if (!err)
+                                err = _parser.on_null();
+                            p += 4;
+                            break;
+                        case '-':
+                        case '0':
+                        case '1':
+                        case '2':
+                        case '3':
+                        case '4':
+                        case '5':
+                        case '6':
+                        case '7':
+                        case '8':
+                        case '9':
+                            err = _parser.on_number_begin();
+                            if (!err)
+                                err = _decimal.scan(p, end, p);
+                            if (!err)
+                                err = _parser.on_number(_decimal.get());
+                            break;
+                        default:
+                            return parse_error_t::unknown_space;
+                    }
+                    if (err and *err == parse_error_t::skip) {
+                        err = skip_dropped<B>(p, end);
+                        if (!err)
+                            err = _parser.on_skipped();
+                    }
+                    if (err) {
+                        if (*err != parse_error_t::happy_ending)
+                            return err;
+                        _consumed = p;
+                        return {};
+                    }
                 }
+            }
 
-                state_t state;
-                parser* parent;
-            };
-
-            using sub_parser = std::variant<
-                json_parser,
-                object_parser,
-                A_parser,
-                B_parser,
-                pair_parser,
-                value_parser,
-                array_parser,
-                C_parser,
-                elements_parser,
-                D_parser
-            >;
+            // End of the document.
+            const char* consumed()const noexcept {
+                return _consumed;
+            }
 
-            std::vector<sub_parser> _stack;
+            private:
+            parser<B>& _parser;
+            decimal _decimal;
+            const char* _consumed = nullptr;
         };
 
         struct document_printer {
@@ -1777,23 +3772,23 @@ namespace json {
                 return {};
             }
 
-            std::optional<parse_error_t> on_key(std::string key)noexcept {
+            std::optional<parse_error_t> on_key(std::string_view key)noexcept {
                 // print_space();
                 // std::cout << std::format("key:\"{}\"\n", key);
                 ++_res;
                 return {};
             }
 
-            std::optional<parse_error_t> on_string(std::string str)noexcept {
+            std::optional<parse_error_t> on_string(std::string_view str)noexcept {
                 // print_space();
                 // std::cout << std::format("string:\"{}\"\n", str);
                 ++_res;
                 return {};
             }
 
-            std::optional<parse_error_t> on_number(std::string num)noexcept {
+            std::optional<parse_error_t> on_number(const double x)noexcept {
                 // print_space();
-                // std::cout << std::format("number:{}\n", num);
+                // std::cout << std::format("number:{}\n", x);
                 ++_res;
                 return {};
             }
@@ -1814,6 +3809,11 @@ namespace json {
 
             int get()noexcept { return _res; }
 
+            void reset()noexcept {
+                _res = 0;
+                _depth = 0;
+            }
+
             private:
             void print_space()const noexcept {
                 std::string str(_depth * 4, ' ');
@@ -1828,222 +3828,1056 @@ namespace json {
     }
 
 
-    struct value {
+    // Stores each distinct key once, at an address that stays valid for the lifetime of the table, so that
+    // objects can refer to it instead of keeping a copy. Safe to share between threads.
+    struct symbol_table {
+        explicit symbol_table(std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+            :_chars{ upstream }, _keys{ upstream } {}
 
-        constexpr value()noexcept = default;
+        symbol_table(const symbol_table&) = delete;
+        symbol_table& operator=(const symbol_table&) = delete;
 
-        template<class T>
-            requires
-        std::same_as<T, double> ||
-            std::same_as<T, bool> ||
-            std::constructible_from<std::string, T> ||
-            std::constructible_from<std::vector<value>, T> ||
-            std::constructible_from<std::map<std::string, value>, T> ||
-            std::constructible_from<std::monostate, T>
-            constexpr value(T&& x)noexcept :
-            data{ std::forward<T>(x) } {}
+        std::string_view intern(std::string_view key) {
+            {
+                std::shared_lock lock{ _mutex };
+                if (auto iter = _keys.find(key); iter != _keys.end())
+                    return *iter;
+            }
+            std::unique_lock lock{ _mutex };
+            if (auto iter = _keys.find(key); iter != _keys.end())
+                return *iter;
+            auto chars = static_cast<char*>(_chars.allocate(key.size(), 1));
+            std::memcpy(chars, key.data(), key.size());
+            return *_keys.emplace(chars, key.size()).first;
+        }
 
+        size_t size()const {
+            std::shared_lock lock{ _mutex };
+            return _keys.size();
+        }
+
+        private:
+        mutable std::shared_mutex _mutex;
+        std::pmr::monotonic_buffer_resource _chars;
+        std::pmr::unordered_set<std::string_view> _keys;
+    };
+
+    // A key of an object in 16 bytes. Up to inline_capacity bytes live in the key itself, a longer key
+    // is a pointer and a size, to characters owned by its object or interned in a symbol_table.
+    struct object_key {
+        static constexpr size_t inline_capacity = 15;
+
+        constexpr object_key()noexcept {
+            _bytes[15] = inline_capacity;
+        }
+
+        constexpr bool is_inline()const noexcept {
+            return _bytes[15] != _long_tag;
+        }
+
+        const char* data()const noexcept {
+            if (is_inline())
+                return _bytes;
+            const char* p;
+            std::memcpy(&p, _bytes, sizeof(p));
+            return p;
+        }
+
+        size_t size()const noexcept {
+            if (is_inline())
+                return inline_capacity - _bytes[15];
+            uint32_t n;
+            std::memcpy(&n, _bytes + 8, sizeof(n));
+            return n;
+        }
+
+        bool empty()const noexcept {
+            return size() == 0;
+        }
+
+        std::string_view view()const noexcept {
+            return { data(), size() };
+        }
+
+        operator std::string_view()const noexcept {
+            return view();
+        }
+
+        // Equal inline keys have equal bytes and keys interned in one table the same pointer, so this
+        // only reads the characters of long keys that were not.
+        friend bool operator==(const object_key& a, const object_key& b)noexcept {
+            if (std::memcmp(a._bytes, b._bytes, sizeof(_bytes)) == 0)
+                return true;
+            return !a.is_inline() and !b.is_inline() and a.view() == b.view();
+        }
+
+        friend bool operator==(const object_key& a, std::string_view b)noexcept {
+            return a.view() == b;
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const object_key& key) {
+            return os << key.view();
+        }
+
+        private:
+        template<class V>
+        friend struct basic_object;
+
+        static constexpr char _long_tag = char(0x80);
+
+        static object_key _inline(std::string_view key)noexcept {
+            assert(key.size() <= inline_capacity);
+            object_key res;
+            std::memcpy(res._bytes, key.data(), key.size());
+            res._bytes[15] = static_cast<char>(inline_capacity - key.size());
+            return res;
+        }
+
+        static object_key _pointer(const char* p, size_t size)noexcept {
+            assert(size > inline_capacity and size <= std::numeric_limits<uint32_t>::max());
+            object_key res;
+            const auto n = static_cast<uint32_t>(size);
+            std::memcpy(res._bytes, &p, sizeof(p));
+            std::memcpy(res._bytes + 8, &n, sizeof(n));
+            res._bytes[15] = _long_tag;
+            return res;
+        }
+
+        alignas(8) char _bytes[16]{};
+    };
+
+    // Members in insertion order in one vector. Small objects are searched linearly, from index_threshold
+    // members on an open addressing table of positions is kept beside them. Long keys are copied to the
+    // object's resource, or interned when the object uses a symbol_table. Keys must not be changed in place.
+    template<class V>
+    struct basic_object {
+        using key_type = object_key;
+        using mapped_type = V;
+        using value_type = std::pair<object_key, V>;
+        using allocator_type = std::pmr::polymorphic_allocator<>;
+        using iterator = typename std::pmr::vector<value_type>::iterator;
+        using const_iterator = typename std::pmr::vector<value_type>::const_iterator;
+
+        static constexpr size_t index_threshold = 16;
+
+        basic_object()noexcept = default;
+
+        explicit basic_object(const allocator_type& alloc)noexcept :_items(alloc), _index(alloc) {}
+
+        basic_object(const basic_object& other) :basic_object(other, allocator_type{}) {}
+
+        basic_object(basic_object&& other)noexcept = default;
+
+        // Copies own their keys.
+        basic_object(const basic_object& other, const allocator_type& alloc) :basic_object(alloc) {
+            _copy_from(other);
+        }
+
+        basic_object(basic_object&& other, const allocator_type& alloc) :basic_object(alloc) {
+            *this = std::move(other);
+        }
+
+        basic_object(std::initializer_list<std::pair<const std::string, V>> members, const allocator_type& alloc = {})
+            :basic_object(alloc) {
+            for (const auto& [k, v] : members)
+                try_emplace(k, v);
+        }
+
+        ~basic_object() {
+            _free_keys();
+        }
+
+        basic_object& operator=(const basic_object& other) {
+            if (this != &other) {
+                clear();
+                _copy_from(other);
+            }
+            return *this;
+        }
+
+        basic_object& operator=(basic_object&& other)noexcept {
+            if (this == &other)
+                return *this;
+            if (get_allocator() != other.get_allocator())
+                return *this = std::as_const(other);
+            clear();
+            _items = std::move(other._items);
+            _index = std::move(other._index);
+            _symbols = other._symbols;
+            other._items.clear();
+            other._index.clear();
+            return *this;
+        }
+
+        allocator_type get_allocator()const noexcept {
+            return _items.get_allocator();
+        }
+
+        // Interns the long keys of members added from now on in symbols, which has to outlive the object.
+        void use_symbols(symbol_table* symbols)noexcept {
+            assert(empty());
+            _symbols = symbols;
+        }
+
+        symbol_table* symbols()const noexcept {
+            return _symbols;
+        }
+
+        template<class... Args>
+        std::pair<iterator, bool> try_emplace(std::string_view key, Args&&... args) {
+            if (auto pos = _find(key); pos != npos)
+                return { begin() + pos, false };
+            _items.emplace_back(std::piecewise_construct, std::forward_as_tuple(_make_key(key)),
+                std::forward_as_tuple(std::forward<Args>(args)...));
+            if (!_index.empty() and _items.size() * 2 <= _index.size())
+                _index_insert(_items.size() - 1);
+            else if (_items.size() >= index_threshold)
+                _rebuild_index();
+            return { end() - 1, true };
+        }
+
+        std::pair<iterator, bool> emplace(std::string_view key, V v) {
+            return try_emplace(key, std::move(v));
+        }
+
+        std::pair<iterator, bool> insert(std::pair<std::string_view, V> member) {
+            return try_emplace(member.first, std::move(member.second));
+        }
+
+        V& operator[](std::string_view key) {
+            return try_emplace(key).first->second;
+        }
+
+        V& at(std::string_view key) {
+            return const_cast<V&>(std::as_const(*this).at(key));
+        }
+
+        const V& at(std::string_view key)const {
+            auto pos = _find(key);
+            if (pos == npos)
+                throw std::out_of_range("json::object::at");
+            return _items[pos].second;
+        }
+
+        iterator find(std::string_view key)noexcept {
+            auto pos = _find(key);
+            return pos == npos ? end() : begin() + pos;
+        }
+
+        const_iterator find(std::string_view key)const noexcept {
+            auto pos = _find(key);
+            return pos == npos ? end() : begin() + pos;
+        }
+
+        // A key of an object sharing the symbol table is found by comparing pointers.
+        iterator find(const object_key& key)noexcept {
+            auto pos = _find(key);
+            return pos == npos ? end() : begin() + pos;
+        }
+
+        const_iterator find(const object_key& key)const noexcept {
+            auto pos = _find(key);
+            return pos == npos ? end() : begin() + pos;
+        }
+
+        bool contains(std::string_view key)const noexcept {
+            return _find(key) != npos;
+        }
+
+        size_t count(std::string_view key)const noexcept {
+            return contains(key);
+        }
+
+        // Keeps the order of the remaining members.
+        iterator erase(const_iterator pos) {
+            _free_key(pos->first);
+            auto next = _items.erase(pos);
+            _rebuild_index();
+            return next;
+        }
+
+        size_t erase(std::string_view key) {
+            auto pos = _find(key);
+            if (pos == npos)
+                return 0;
+            erase(begin() + pos);
+            return 1;
+        }
+
+        void clear()noexcept {
+            _free_keys();
+            _items.clear();
+            _index.clear();
+        }
+
+        void reserve(const size_t n) {
+            _items.reserve(n);
+        }
+
+        size_t size()const noexcept {
+            return _items.size();
+        }
+
+        bool empty()const noexcept {
+            return _items.empty();
+        }
+
+        iterator begin()noexcept {
+            return _items.begin();
+        }
+
+        iterator end()noexcept {
+            return _items.end();
+        }
+
+        const_iterator begin()const noexcept {
+            return _items.begin();
+        }
+
+        const_iterator end()const noexcept {
+            return _items.end();
+        }
+
+        // Equal members in any order.
+        bool operator==(const basic_object& other)const noexcept {
+            if (size() != other.size())
+                return false;
+            for (const auto& [k, v] : _items) {
+                auto pos = other._find(k);
+                if (pos == npos or !(other._items[pos].second == v))
+                    return false;
+            }
+            return true;
+        }
+
+        private:
+        static constexpr size_t npos = size_t(-1);
+
+        static size_t _hash(std::string_view key)noexcept {
+            return std::hash<std::string_view>{}(key);
+        }
+
+        template<class K>
+        size_t _find(const K& key)const noexcept {
+            if (_index.empty()) {
+                for (size_t i = 0; i < _items.size(); ++i)
+                    if (_items[i].first == key)
+                        return i;
+                return npos;
+            }
+            const size_t mask = _index.size() - 1;
+            for (size_t slot = _hash(std::string_view(key)) & mask; _index[slot] != 0; slot = (slot + 1) & mask) {
+                const size_t i = _index[slot] - 1;
+                if (_items[i].first == key)
+                    return i;
+            }
+            return npos;
+        }
+
+        void _index_insert(const size_t i)noexcept {
+            const size_t mask = _index.size() - 1;
+            size_t slot = _hash(_items[i].first.view()) & mask;
+            while (_index[slot] != 0)
+                slot = (slot + 1) & mask;
+            _index[slot] = static_cast<uint32_t>(i + 1);
+        }
+
+        void _rebuild_index() {
+            _index.clear();
+            if (_items.size() < index_threshold)
+                return;
+            _index.resize(std::bit_ceil(_items.size() * 4));
+            for (size_t i = 0; i < _items.size(); ++i)
+                _index_insert(i);
+        }
+
+        object_key _make_key(std::string_view key) {
+            if (key.size() <= object_key::inline_capacity)
+                return object_key::_inline(key);
+            if (_symbols)
+                return object_key::_pointer(_symbols->intern(key).data(), key.size());
+            auto chars = static_cast<char*>(get_allocator().allocate_bytes(key.size(), 1));
+            std::memcpy(chars, key.data(), key.size());
+            return object_key::_pointer(chars, key.size());
+        }
+
+        void _free_key(const object_key& key)noexcept {
+            if (!_symbols and !key.is_inline())
+                get_allocator().deallocate_bytes(const_cast<char*>(key.data()), key.size(), 1);
+        }
+
+        void _free_keys()noexcept {
+            if (!_symbols)
+                for (const auto& member : _items)
+                    _free_key(member.first);
+        }
+
+        // into an empty object
+        void _copy_from(const basic_object& other) {
+            _symbols = nullptr;
+            _items.reserve(other.size());
+            for (const auto& [k, v] : other._items)
+                _items.emplace_back(_make_key(k.view()), v);
+            _index.assign(other._index.begin(), other._index.end());
+        }
+
+        std::pmr::vector<value_type> _items;
+        // slots hold a position in _items plus one, zero when free
+        std::pmr::vector<uint32_t> _index;
+        symbol_table* _symbols = nullptr;
+    };
+
+    // 16 bytes: a double or a bool inline, strings and containers out of line behind a pointer, and a tag.
+    // Out of line storage comes from a std::pmr::memory_resource, the default resource unless one is given,
+    // and is returned to the resource recorded in the string or container itself.
+    struct value {
+
+        constexpr value()noexcept = default;
+
+        template<class T>
+            requires
+        std::same_as<T, double> ||
+            std::same_as<T, bool> ||
+            std::constructible_from<std::pmr::string, T> ||
+            std::constructible_from<std::pmr::vector<value>, T> ||
+            std::constructible_from<basic_object<value>, T> ||
+            std::constructible_from<std::monostate, T>
+            value(T&& x)noexcept {
+            using U = std::remove_cvref_t<T>;
+            if constexpr (std::same_as<U, bool>)
+                emplace_bool(x);
+            else if constexpr (std::is_arithmetic_v<U>)
+                emplace_number(static_cast<double>(x));
+            else if constexpr (std::same_as<U, std::monostate>)
+                emplace_null();
+            else if constexpr (std::constructible_from<std::pmr::string, T>)
+                _set(tag_t::string, &storage_t::string, _make_from<std::pmr::string>(std::forward<T>(x)));
+            else if constexpr (std::constructible_from<basic_object<value>, T>)
+                _set(tag_t::object, &storage_t::object, _make_from<basic_object<value>>(std::forward<T>(x)));
+            else
+                _set(tag_t::array, &storage_t::array, _make_from<std::pmr::vector<value>>(std::forward<T>(x)));
+        }
+
+
+        value(std::initializer_list<value> arr)noexcept {
+            emplace_array(std::pmr::vector<value>(arr));
+        }
+
+        value(std::initializer_list<std::pair<const std::string, value>> obj)noexcept {
+            emplace_object(basic_object<value>(obj));
+        }
+
+        // Copies go to the default resource.
+        value(const value& other)noexcept {
+            switch (other._tag) {
+                case tag_t::string:
+                    _set(tag_t::string, &storage_t::string, _make_from<std::pmr::string>(*other._storage.string));
+                    break;
+                case tag_t::array:
+                    _set(tag_t::array, &storage_t::array, _make_from<std::pmr::vector<value>>(*other._storage.array));
+                    break;
+                case tag_t::object:
+                    _set(tag_t::object, &storage_t::object, _make_from<basic_object<value>>(*other._storage.object));
+                    break;
+                default:
+                    _storage = other._storage;
+                    _tag = other._tag;
+                    break;
+            }
+        }
 
-        constexpr value(std::initializer_list<value> arr)noexcept {
-            data.emplace<std::vector<value>>(std::move(arr));
+        constexpr value(value&& other)noexcept :_storage{ other._storage }, _tag{ other._tag } {
+            other._tag = tag_t::null;
         }
 
-        constexpr value(std::initializer_list<std::pair<const std::string, value>> obj)noexcept {
-            data.emplace<std::map<std::string, value>>(std::move(obj));
+        ~value() {
+            _clear();
         }
 
-        constexpr value(const value&)noexcept = default;
-        constexpr value(value&&)noexcept = default;
+        value& operator=(const value& other)noexcept {
+            if (this != &other)
+                value(other).swap(*this);
+            return *this;
+        }
 
-        constexpr value& operator=(const value& other)noexcept = default;
-        constexpr value& operator=(value&& other)noexcept = default;
+        value& operator=(value&& other)noexcept {
+            value(std::move(other)).swap(*this);
+            return *this;
+        }
 
-        constexpr value& operator=(std::initializer_list<value> arr)noexcept {
-            data.emplace<std::vector<value>>(std::move(arr));
+        value& operator=(std::initializer_list<value> arr)noexcept {
+            emplace_array(std::pmr::vector<value>(arr));
             return *this;
         }
 
-        constexpr value& operator=(std::initializer_list<std::pair<const std::string, value>> obj)noexcept {
-            data.emplace<std::map<std::string, value>>(std::move(obj));
+        value& operator=(std::initializer_list<std::pair<const std::string, value>> obj)noexcept {
+            emplace_object(basic_object<value>(obj));
             return *this;
         }
 
         constexpr bool is_number()const noexcept {
-            return std::holds_alternative<double>(data);
+            return _tag == tag_t::number;
         }
 
         constexpr bool is_string()const noexcept {
-            return std::holds_alternative<std::string>(data);
+            return _tag == tag_t::string;
         }
 
         constexpr bool is_null()const noexcept {
-            return std::holds_alternative<std::monostate>(data);
+            return _tag == tag_t::null;
         }
 
         constexpr bool is_bool()const noexcept {
-            return std::holds_alternative<bool>(data);
+            return _tag == tag_t::boolean;
         }
 
         constexpr bool is_array()const noexcept {
-            return std::holds_alternative<std::vector<value>>(data);
+            return _tag == tag_t::array;
         }
 
         constexpr bool is_object()const noexcept {
-            return std::holds_alternative<std::map<std::string, value>>(data);
+            return _tag == tag_t::object;
         }
 
         auto& get_object() {
-            return std::get<std::map<std::string, value>>(data);
+            _expect(tag_t::object);
+            return *_storage.object;
         }
 
         constexpr const auto& get_object()const {
-            return std::get<std::map<std::string, value>>(data);
+            _expect(tag_t::object);
+            return *_storage.object;
+        }
+
+        auto& get_array() {
+            _expect(tag_t::array);
+            return *_storage.array;
+        }
+
+        constexpr const auto& get_array()const {
+            _expect(tag_t::array);
+            return *_storage.array;
+        }
+
+        auto& get_number() {
+            _expect(tag_t::number);
+            return _storage.number;
+        }
+
+        constexpr auto get_number()const {
+            _expect(tag_t::number);
+            return _storage.number;
+        }
+
+        auto& get_string() {
+            _expect(tag_t::string);
+            return *_storage.string;
+        }
+
+        constexpr const auto& get_string()const {
+            _expect(tag_t::string);
+            return *_storage.string;
+        }
+
+        bool& get_bool() {
+            _expect(tag_t::boolean);
+            return _storage.boolean;
+        }
+
+        constexpr bool get_bool()const {
+            _expect(tag_t::boolean);
+            return _storage.boolean;
+        }
+
+        constexpr std::monostate get_null()const {
+            _expect(tag_t::null);
+            return {};
+        }
+
+        void emplace_null(const std::monostate = {})noexcept {
+            _clear();
+        }
+
+        double& emplace_number()noexcept {
+            emplace_number(0.0);
+            return _storage.number;
+        }
+
+        void emplace_number(const double x)noexcept {
+            _set(tag_t::number, &storage_t::number, x);
+        }
+
+        bool& emplace_bool()noexcept {
+            emplace_bool(false);
+            return _storage.boolean;
+        }
+
+        void emplace_bool(const bool b)noexcept {
+            _set(tag_t::boolean, &storage_t::boolean, b);
+        }
+
+        std::pmr::string& emplace_string(std::pmr::memory_resource* mr = std::pmr::get_default_resource())noexcept {
+            emplace_string({}, mr);
+            return *_storage.string;
+        }
+
+        void emplace_string(std::string_view str, std::pmr::memory_resource* mr = std::pmr::get_default_resource())noexcept {
+            _set(tag_t::string, &storage_t::string, _make<std::pmr::string>(mr, str));
+        }
+
+        auto& emplace_array(std::pmr::memory_resource* mr = std::pmr::get_default_resource())noexcept {
+            _set(tag_t::array, &storage_t::array, _make<std::pmr::vector<value>>(mr));
+            return *_storage.array;
+        }
+
+        // Takes the elements over, along with their resource.
+        void emplace_array(std::pmr::vector<value> arr)noexcept {
+            _set(tag_t::array, &storage_t::array, _make_from<std::pmr::vector<value>>(std::move(arr)));
+        }
+
+        auto& emplace_object(std::pmr::memory_resource* mr = std::pmr::get_default_resource())noexcept {
+            _set(tag_t::object, &storage_t::object, _make<basic_object<value>>(mr));
+            return *_storage.object;
+        }
+
+        void emplace_object(basic_object<value> obj)noexcept {
+            _set(tag_t::object, &storage_t::object, _make_from<basic_object<value>>(std::move(obj)));
+        }
+
+        auto& operator[](std::string_view key) {
+            return get_object()[key];
+        }
+
+        const auto& operator[](std::string_view key)const {
+            return get_object().at(key);
+        }
+
+        auto& operator[](const size_t index) {
+            return get_array()[index];
+        }
+
+        const auto& operator[](const size_t index)const {
+            return get_array()[index];
+        }
+
+        // Calls f with what the value holds: std::monostate, bool, double, std::pmr::string, array or object.
+        template<class F>
+        constexpr decltype(auto) visit(F&& f)const {
+            switch (_tag) {
+                case tag_t::boolean:
+                    return f(_storage.boolean);
+                case tag_t::number:
+                    return f(_storage.number);
+                case tag_t::string:
+                    return f(std::as_const(*_storage.string));
+                case tag_t::array:
+                    return f(std::as_const(*_storage.array));
+                case tag_t::object:
+                    return f(std::as_const(*_storage.object));
+                default:
+                    return f(std::monostate{});
+            }
         }
 
-        auto& get_array() {
-            return std::get<std::vector<value>>(data);
+        auto operator==(const value& other)const noexcept {
+            if (_tag != other._tag)
+                return false;
+            return visit([&](const auto& x)noexcept {
+                return other.visit([&](const auto& y)noexcept {
+                    if constexpr (std::same_as<decltype(x), decltype(y)>)
+                        return x == y;
+                    else return false;
+                    });
+                });
+        }
+
+        constexpr void swap(value& other)noexcept {
+            std::swap(_storage, other._storage);
+            std::swap(_tag, other._tag);
+        }
+
+        constexpr std::string type()const noexcept {
+            switch (_tag) {
+                case tag_t::null:
+                    return "null";
+                case tag_t::array:
+                    return "array";
+                case tag_t::object:
+                    return "object";
+                case tag_t::number:
+                    return "number";
+                case tag_t::string:
+                    return "string";
+                case tag_t::boolean:
+                    return "boolean";
+            }
+            return "";
+        }
+
+        private:
+        enum struct tag_t : uint8_t {
+            null,
+            boolean,
+            number,
+            string,
+            array,
+            object
+        };
+
+        union storage_t {
+            double number;
+            bool boolean;
+            std::pmr::string* string;
+            std::pmr::vector<value>* array;
+            basic_object<value>* object;
+        };
+
+        // Frees what was held before storing x, which may come from it.
+        template<class M, class T>
+        void _set(const tag_t tag, M storage_t::* member, T x)noexcept {
+            _clear();
+            _storage.*member = x;
+            _tag = tag;
+        }
+
+        template<class T, class... Args>
+        static T* _make(std::pmr::memory_resource* mr, Args&&... args) {
+            return std::pmr::polymorphic_allocator<>{ mr }.new_object<T>(std::forward<Args>(args)...);
+        }
+
+        // An rvalue string or container keeps its resource, anything else is copied to the default one.
+        template<class T, class X>
+        static T* _make_from(X&& x) {
+            if constexpr (std::same_as<X, T>)
+                return _make<T>(x.get_allocator().resource(), std::move(x));
+            else return _make<T>(std::pmr::get_default_resource(), std::forward<X>(x));
+        }
+
+        template<class T>
+        static void _delete(T* p)noexcept {
+            std::pmr::polymorphic_allocator<>{ p->get_allocator().resource() }.delete_object(p);
+        }
+
+        void _clear()noexcept {
+            switch (_tag) {
+                case tag_t::string:
+                    _delete(_storage.string);
+                    break;
+                case tag_t::array:
+                    _delete(_storage.array);
+                    break;
+                case tag_t::object:
+                    _delete(_storage.object);
+                    break;
+                default:
+                    break;
+            }
+            _tag = tag_t::null;
+        }
+
+        constexpr void _expect(const tag_t tag)const {
+            if (_tag != tag)
+                throw std::bad_variant_access{};
+        }
+
+        storage_t _storage{ .number = 0 };
+        tag_t _tag = tag_t::null;
+    };
+
+    static_assert(sizeof(value) == 16);
+
+    static constexpr std::monostate null{};
+    using array = std::pmr::vector<value>;
+    using object = basic_object<value>;
+    using document = std::variant<std::monostate, array, object>;
+
+    enum struct tape_t : uint8_t {
+        null_value,
+        true_value,
+        false_value,
+        number,         // the double is in the next word
+        string,         // payload: offset of the 4 byte size and the bytes in the string buffer
+        array_begin,    // payload: distance to the matching end
+        array_end,
+        object_begin,   // payload: distance to the matching end, keys and values alternate up to it
+        object_end,
+        borrowed_string // payload: size, the next word points at the bytes, which belong to the parsed input
+    };
+
+    // Read only view of a node of a tape_document, cheap to copy. Lives as long as the document does.
+    struct tape_view {
+        // Steps over sibling nodes, containers in one jump through their skip offset.
+        struct iterator {
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = tape_view;
+            using difference_type = std::ptrdiff_t;
+
+            constexpr iterator()noexcept = default;
+            constexpr iterator(const uint64_t* word, const char* strings)noexcept :_word{ word }, _strings{ strings } {}
+
+            constexpr tape_view operator*()const noexcept {
+                return { _word, _strings };
+            }
+
+            constexpr iterator& operator++()noexcept {
+                _word = tape_view{ _word, _strings }.next()._word;
+                return *this;
+            }
+
+            constexpr iterator operator++(int)noexcept {
+                auto it = *this;
+                ++*this;
+                return it;
+            }
+
+            constexpr bool operator==(const iterator& other)const noexcept {
+                return _word == other._word;
+            }
+
+            private:
+            const uint64_t* _word = nullptr;
+            const char* _strings = nullptr;
+        };
+
+        // Key and value pairs of an object.
+        struct member_iterator {
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::pair<std::string_view, tape_view>;
+            using difference_type = std::ptrdiff_t;
+
+            constexpr member_iterator()noexcept = default;
+            constexpr member_iterator(const uint64_t* key, const char* strings)noexcept :_key{ key }, _strings{ strings } {}
+
+            value_type operator*()const noexcept {
+                const tape_view key{ _key, _strings };
+                return { key.get_string(), key.next() };
+            }
+
+            constexpr member_iterator& operator++()noexcept {
+                _key = tape_view{ _key, _strings }.next().next()._word;
+                return *this;
+            }
+
+            constexpr member_iterator operator++(int)noexcept {
+                auto it = *this;
+                ++*this;
+                return it;
+            }
+
+            constexpr bool operator==(const member_iterator& other)const noexcept {
+                return _key == other._key;
+            }
+
+            private:
+            const uint64_t* _key = nullptr;
+            const char* _strings = nullptr;
+        };
+
+        constexpr tape_view()noexcept = default;
+        constexpr tape_view(const uint64_t* word, const char* strings)noexcept :_word{ word }, _strings{ strings } {}
+
+        constexpr tape_t type()const noexcept {
+            return static_cast<tape_t>(*_word >> 56);
         }
 
-        constexpr const auto& get_array()const {
-            return std::get<std::vector<value>>(data);
+        constexpr bool is_null()const noexcept {
+            return type() == tape_t::null_value;
         }
 
-        auto& get_number() {
-            return std::get<double>(data);
+        constexpr bool is_bool()const noexcept {
+            return type() == tape_t::true_value or type() == tape_t::false_value;
         }
 
-        constexpr auto get_number()const {
-            return std::get<double>(data);
+        constexpr bool is_number()const noexcept {
+            return type() == tape_t::number;
         }
 
-        auto& get_string() {
-            return std::get<std::string>(data);
+        constexpr bool is_string()const noexcept {
+            return type() == tape_t::string or type() == tape_t::borrowed_string;
         }
 
-        constexpr const auto& get_string()const {
-            return std::get<std::string>(data);
+        constexpr bool is_array()const noexcept {
+            return type() == tape_t::array_begin;
         }
 
-        bool& get_bool() {
-            return std::get<bool>(data);
+        constexpr bool is_object()const noexcept {
+            return type() == tape_t::object_begin;
         }
 
-        constexpr bool get_bool()const {
-            return std::get<bool>(data);
+        constexpr bool get_bool()const noexcept {
+            assert(is_bool());
+            return type() == tape_t::true_value;
         }
 
-        constexpr std::monostate get_null()const {
-            return std::get<std::monostate>(data);
+        constexpr double get_number()const noexcept {
+            assert(is_number());
+            return std::bit_cast<double>(_word[1]);
         }
 
-        void emplace_null(const std::monostate = {})noexcept {
-            data.emplace<std::monostate>();
+        std::string_view get_string()const noexcept {
+            assert(is_string());
+            if (type() == tape_t::borrowed_string)
+                return { std::bit_cast<const char*>(_word[1]), _payload() };
+            uint32_t size;
+            std::memcpy(&size, _strings + _payload(), sizeof(size));
+            return { _strings + _payload() + sizeof(size), size };
         }
 
-        double& emplace_number()noexcept {
-            data.emplace<double>();
-            return std::get<double>(data);
+        // Elements of an array.
+        constexpr iterator begin()const noexcept {
+            assert(is_array());
+            return { _word + 1, _strings };
         }
 
-        void emplace_number(const double x)noexcept {
-            data.emplace<double>(x);
+        constexpr iterator end()const noexcept {
+            assert(is_array());
+            return { _word + _payload(), _strings };
         }
 
-        bool& emplace_bool()noexcept {
-            data.emplace<bool>();
-            return std::get<bool>(data);
+        constexpr auto members()const noexcept {
+            assert(is_object());
+            return std::ranges::subrange{ member_iterator{ _word + 1, _strings }, member_iterator{ _word + _payload(), _strings } };
         }
 
-        void emplace_bool(const bool b)noexcept {
-            data.emplace<bool>(b);
+        // Elements of an array or members of an object, counted by walking them.
+        constexpr size_t size()const noexcept {
+            if (is_object())
+                return std::ranges::distance(members());
+            return std::ranges::distance(begin(), end());
         }
 
-        std::string& emplace_string()noexcept {
-            data.emplace<std::string>();
-            return std::get<std::string>(data);
+        // Linear in index.
+        constexpr tape_view operator[](const size_t index)const noexcept {
+            assert(index < size());
+            return *std::ranges::next(begin(), index);
         }
 
-        void emplace_string(std::string str)noexcept {
-            data.emplace<std::string>(std::move(str));
+        // First member named key, linear in the size of the object.
+        std::optional<tape_view> find(const std::string_view key)const noexcept {
+            for (const auto [k, v] : members()) {
+                if (k == key)
+                    return v;
+            }
+            return std::nullopt;
         }
 
-        auto& emplace_array()noexcept {
-            data.emplace<std::vector<value>>();
-            return std::get<std::vector<value>>(data);
+        // The node after this one and its subtree.
+        constexpr tape_view next()const noexcept {
+            switch (type()) {
+                case tape_t::array_begin:
+                case tape_t::object_begin:
+                    return { _word + _payload() + 1, _strings };
+                case tape_t::number:
+                case tape_t::borrowed_string:
+                    return { _word + 2, _strings };
+                default:
+                    return { _word + 1, _strings };
+            }
         }
 
-        void emplace_array(std::vector<value> arr)noexcept {
-            data.emplace<std::vector<value>>(std::move(arr));
+        // Copies the subtree, allocating like any json::value.
+        json::value to_value()const {
+            switch (type()) {
+                case tape_t::null_value:
+                    return {};
+                case tape_t::true_value:
+                    return true;
+                case tape_t::false_value:
+                    return false;
+                case tape_t::number:
+                    return get_number();
+                case tape_t::string:
+                case tape_t::borrowed_string:
+                    return get_string();
+                case tape_t::array_begin:
+                    {
+                        json::array arr;
+                        for (const auto v : *this)
+                            arr.push_back(v.to_value());
+                        return arr;
+                    }
+                case tape_t::object_begin:
+                    {
+                        json::object obj;
+                        for (const auto [k, v] : members())
+                            obj.try_emplace(k, v.to_value());
+                        return obj;
+                    }
+                default:
+                    std::unreachable();
+            }
         }
 
-        auto& emplace_object()noexcept {
-            data.emplace<std::map<std::string, value>>();
-            return std::get<std::map<std::string, value>>(data);
+        private:
+        constexpr uint64_t _payload()const noexcept {
+            return *_word & ((uint64_t{ 1 } << 56) - 1);
         }
 
-        void emplace_object(std::map<std::string, value> obj)noexcept {
-            data.emplace<std::map<std::string, value>>(std::move(obj));
-        }
+        const uint64_t* _word = nullptr;
+        const char* _strings = nullptr;
+    };
 
-        auto& operator[](const std::string& key) {
-            return get_object()[key];
-        }
+    namespace detail {
+        struct tape_builder;
+        struct view_builder;
+    }
 
-        const auto& operator[](const std::string& key)const {
-            return get_object().at(key);
+    // A document as one flat array of 64 bit words in document order plus one buffer for all strings, a
+    // couple of allocations whatever its shape. A word holds a tape_t in its high byte and a payload.
+    // Build it with json::parse_tape, views stay valid when it is moved.
+    struct tape_document {
+        tape_view root()const noexcept {
+            assert(!_tape.empty());
+            return { _tape.data(), _strings.data() };
         }
 
-        auto& operator[](const size_t index) {
-            return get_array()[index];
+        json::document to_document()const {
+            auto v = root().to_value();
+            if (v.is_array())
+                return std::move(v.get_array());
+            return std::move(v.get_object());
         }
 
-        const auto& operator[](const size_t index)const {
-            return get_array()[index];
-        }
+        private:
+        friend struct detail::tape_builder;
+        friend struct detail::view_builder;
 
-        auto operator==(const value& other)const noexcept {
-            return data == other.data;
+        std::vector<uint64_t> _tape;
+        std::vector<char> _strings;
+    };
+
+    // A tape_document made by parse_view. Its strings and keys without escapes are views of the parsed
+    // input instead of copies, so it and every string_view taken from it are valid only as long as that
+    // buffer is, unchanged. Only strings with escapes are decoded into the document itself.
+    struct view_document {
+        tape_view root()const noexcept {
+            return _doc.root();
         }
 
-        void swap(value& other)noexcept {
-            std::swap(data, other.data);
+        json::document to_document()const {
+            return _doc.to_document();
         }
 
-        constexpr std::string type()const noexcept {
-            if (std::holds_alternative<std::monostate>(data))
-                return "null";
-            else if (std::holds_alternative<std::vector<value>>(data))
-                return "array";
-            else if (std::holds_alternative<std::map<std::string, value>>(data))
-                return "object";
-            else if (std::holds_alternative<double>(data))
-                return "number";
-            else if (std::holds_alternative<std::string>(data))
-                return "string";
-            else if (std::holds_alternative<bool>(data))
-                return "boolean";
-            return "";
+        // The buffer the document borrows from.
+        std::string_view input()const noexcept {
+            return _input;
         }
 
-        std::variant<
-            std::monostate,                 // null
-            bool,                           // true false
-            double,
-            std::string,
-            std::vector<value>,             // array
-            std::map<std::string, value>    // object
-        > data;
-    };
+        private:
+        friend struct detail::view_builder;
 
-    static constexpr std::monostate null{};
-    using array = std::vector<value>;
-    using object = std::map<std::string, value>;
-    using document = std::variant<std::monostate, array, object>;
+        tape_document _doc;
+        std::string_view _input;
+    };
 
     namespace detail {
         struct document_builder {
 
-            document_builder(int depth)noexcept :_max_depth{ depth } {}
+            // Every string and container of the document is allocated from mr, long keys are interned in
+            // symbols when there is one.
+            document_builder(int depth, std::pmr::memory_resource* mr = std::pmr::get_default_resource(),
+                symbol_table* symbols = nullptr)noexcept
+                :_max_depth{ depth }, _mr{ mr }, _symbols{ symbols } {}
 
             std::optional<parse_error_t> on_document_begin()noexcept {
                 _stack.push_back(&_res);
@@ -2062,17 +4896,20 @@ namespace json {
                     return parse_error_t::too_deep;
                 std::visit([this](auto s)noexcept {
                     if constexpr (std::is_same_v<json::document*, decltype(s)>) {
-                        s->template emplace<json::object>();
-                        _stack.emplace_back(&std::get<json::object>(*s));
+                        auto& obj = s->template emplace<json::object>(_mr);
+                        obj.use_symbols(_symbols);
+                        _stack.emplace_back(&obj);
                     }
                     else if constexpr (std::is_same_v<json::array*, decltype(s)>) {
                         s->emplace_back();
-                        s->back().data.template emplace<json::object>();
-                        _stack.emplace_back(&std::get<json::object>(s->back().data));
+                        auto& obj = s->back().emplace_object(_mr);
+                        obj.use_symbols(_symbols);
+                        _stack.emplace_back(&obj);
                     }
                     else if constexpr (std::is_same_v<json::object::iterator, decltype(s)>) {
-                        s->second.data.template emplace<json::object>();
-                        _stack.back() = &std::get<json::object>(s->second.data);
+                        auto& obj = s->second.emplace_object(_mr);
+                        obj.use_symbols(_symbols);
+                        _stack.back() = &obj;
                     }
                     }, _stack.back());
                 return {};
@@ -2092,18 +4929,17 @@ namespace json {
                     return parse_error_t::too_deep;
                 std::visit([this](auto s)noexcept {
                     if constexpr (std::is_same_v<json::document*, decltype(s)>) {
-                        s->template emplace<json::array>();
+                        s->template emplace<json::array>(_mr);
                         _stack.emplace_back(&std::get<json::array>(*s));
                     }
                     else if constexpr (std::is_same_v<json::array*, decltype(s)>) {
                         s->emplace_back();
-                        s->back().data.template emplace<json::array>();
-                        _stack.emplace_back(&std::get<json::array>(s->back().data));
+                        _stack.emplace_back(&s->back().emplace_array(_mr));
                     }
                     else if constexpr (std::is_same_v<json::object::iterator, decltype(s)>) {
-                        s->second.data.template emplace<json::array>();
-                        std::get<json::array>(s->second.data).reserve(16);
-                        _stack.back() = &std::get<json::array>(s->second.data);
+                        auto& arr = s->second.emplace_array(_mr);
+                        arr.reserve(16);
+                        _stack.back() = &arr;
                     }
                     }, _stack.back());
                 return {};
@@ -2116,46 +4952,43 @@ namespace json {
                 return {};
             }
 
-            std::optional<parse_error_t> on_key(std::string key)noexcept {
+            std::optional<parse_error_t> on_key(std::string_view key)noexcept {
                 assert(std::get_if<json::object*>(&_stack.back()) != nullptr);
                 return std::visit([&, this](auto s)noexcept->std::optional<parse_error_t> {
                     if constexpr (std::is_same_v<json::object*, decltype(s)>) {
-                        if (s->contains(key))
+                        auto [iter, inserted] = s->try_emplace(key);
+                        if (!inserted)
                             return parse_error_t::duplicate_key;
-                        auto [iter, _] = s->emplace(std::move(key), json::value{});
                         _stack.emplace_back(iter);
                     }
                     return {};
                     }, _stack.back());
             }
 
-            std::optional<parse_error_t> on_string(std::string str)noexcept {
+            std::optional<parse_error_t> on_string(std::string_view str)noexcept {
                 assert(!_stack.empty());
                 std::visit([&, this](auto s)noexcept {
                     if constexpr (std::is_same_v<json::array*, decltype(s)>) {
                         s->emplace_back();
-                        s->back().data.template emplace<std::string>(std::move(str));
+                        s->back().emplace_string(str, _mr);
                     }
                     else if constexpr (std::is_same_v<json::object::iterator, decltype(s)>) {
-                        s->second.data.template emplace<std::string>(std::move(str));
+                        s->second.emplace_string(str, _mr);
                         _stack.pop_back();
                     }
                     }, _stack.back());
                 return {};
             }
 
-            std::optional<parse_error_t> on_number(std::string num)noexcept {
+            std::optional<parse_error_t> on_number(const double x)noexcept {
                 assert(!_stack.empty());
-                double x;
-                if (auto [_, e] = std::from_chars(num.data(), num.data() + num.size(), x); e != std::errc())
-                    x = 0;
                 std::visit([=, this](auto s)noexcept {
                     if constexpr (std::is_same_v<json::array*, decltype(s)>) {
                         s->emplace_back();
-                        s->back().data.template emplace<double>(x);
+                        s->back().emplace_number(x);
                     }
                     else if constexpr (std::is_same_v<json::object::iterator, decltype(s)>) {
-                        s->second.data.template emplace<double>(x);
+                        s->second.emplace_number(x);
                         _stack.pop_back();
                     }
                     }, _stack.back());
@@ -2167,10 +5000,10 @@ namespace json {
                 std::visit([=, this](auto s)noexcept {
                     if constexpr (std::is_same_v<json::array*, decltype(s)>) {
                         s->emplace_back();
-                        s->back().data.template emplace<bool>(b);
+                        s->back().emplace_bool(b);
                     }
                     else if constexpr (std::is_same_v<json::object::iterator, decltype(s)>) {
-                        s->second.data.template emplace<bool>(b);
+                        s->second.emplace_bool(b);
                         _stack.pop_back();
                     }
                     }, _stack.back());
@@ -2198,6 +5031,13 @@ namespace json {
                 return std::move(_res);
             }
 
+            void reset()noexcept {
+                _finish = false;
+                _res = document{};
+                _stack.clear();
+                _depth = 0;
+            }
+
             private:
             using state_type = std::variant<
                 json::document*,
@@ -2211,6 +5051,202 @@ namespace json {
             std::vector<state_type> _stack;
             int _depth = 0;
             int _max_depth;
+            std::pmr::memory_resource* _mr;
+            symbol_table* _symbols;
+        };
+
+        // Appends words to a tape_document, the begin word of a container gets its skip offset when it closes.
+        struct tape_builder {
+            tape_builder(int depth)noexcept :_max_depth{ depth } {}
+
+            std::optional<parse_error_t> on_document_begin()noexcept {
+                return {};
+            }
+
+            std::optional<parse_error_t> on_document_end()noexcept {
+                return {};
+            }
+
+            std::optional<parse_error_t> on_object_begin()noexcept {
+                auto err = _begin(tape_t::object_begin);
+                if (!err)
+                    _objects.push_back({ _keys.size(), {} });
+                return err;
+            }
+
+            std::optional<parse_error_t> on_object_end()noexcept {
+                _keys.resize(_objects.back().begin);
+                _objects.pop_back();
+                return _end(tape_t::object_end);
+            }
+
+            std::optional<parse_error_t> on_array_begin()noexcept {
+                return _begin(tape_t::array_begin);
+            }
+
+            std::optional<parse_error_t> on_array_end()noexcept {
+                return _end(tape_t::array_end);
+            }
+
+            std::optional<parse_error_t> on_key(std::string_view key)noexcept {
+                if (!_add_key(key))
+                    return parse_error_t::duplicate_key;
+                return on_string(key);
+            }
+
+            std::optional<parse_error_t> on_string(std::string_view str)noexcept {
+                auto& strings = _doc._strings;
+                _push(tape_t::string, strings.size());
+                const auto size = static_cast<uint32_t>(str.size());
+                strings.insert(strings.end(), reinterpret_cast<const char*>(&size), reinterpret_cast<const char*>(&size) + sizeof(size));
+                strings.insert(strings.end(), str.begin(), str.end());
+                return {};
+            }
+
+            std::optional<parse_error_t> on_number(const double x)noexcept {
+                _push(tape_t::number, 0);
+                _doc._tape.push_back(std::bit_cast<uint64_t>(x));
+                return {};
+            }
+
+            std::optional<parse_error_t> on_bool(const bool b)noexcept {
+                _push(b ? tape_t::true_value : tape_t::false_value, 0);
+                return {};
+            }
+
+            std::optional<parse_error_t> on_null()noexcept {
+                _push(tape_t::null_value, 0);
+                return {};
+            }
+
+            tape_document get()noexcept {
+                return std::move(_doc);
+            }
+
+            void reset()noexcept {
+                _doc._tape.clear();
+                _doc._strings.clear();
+                _open.clear();
+                _keys.clear();
+                _objects.clear();
+            }
+
+            protected:
+            void _push(const tape_t type, const uint64_t payload)noexcept {
+                _doc._tape.push_back(static_cast<uint64_t>(type) << 56 | payload);
+            }
+
+            struct key_t {
+                // tape position of the key
+                size_t word;
+                // only set once the object is indexed
+                size_t hash;
+            };
+
+            // Keys of an open object are _keys from begin on, searched linearly or, from
+            // json::object::index_threshold keys on, through an open addressing index like json::object's.
+            struct object_keys {
+                size_t begin;
+                std::vector<uint32_t> index;
+            };
+
+            std::string_view _key(const key_t& k)const noexcept {
+                return tape_view{ _doc._tape.data() + k.word, _doc._strings.data() }.get_string();
+            }
+
+            // Records key for the word about to be pushed, false when the current object already has it.
+            bool _add_key(std::string_view key)noexcept {
+                auto& keys = _objects.back();
+                size_t hash = 0;
+                if (keys.index.empty()) {
+                    for (size_t i = keys.begin; i < _keys.size(); ++i)
+                        if (_key(_keys[i]) == key)
+                            return false;
+                }
+                else {
+                    hash = std::hash<std::string_view>{}(key);
+                    const size_t mask = keys.index.size() - 1;
+                    for (size_t slot = hash & mask; keys.index[slot] != 0; slot = (slot + 1) & mask) {
+                        const auto& k = _keys[keys.begin + keys.index[slot] - 1];
+                        if (k.hash == hash and _key(k) == key)
+                            return false;
+                    }
+                }
+                _keys.push_back({ _doc._tape.size(), hash });
+                const size_t n = _keys.size() - keys.begin;
+                if (!keys.index.empty() and n * 2 <= keys.index.size())
+                    _index_key(keys, n - 1);
+                else if (n >= json::object::index_threshold) {
+                    _keys.back().hash = std::hash<std::string_view>{}(key);
+                    if (keys.index.empty())
+                        for (size_t i = keys.begin; i + 1 < _keys.size(); ++i)
+                            _keys[i].hash = std::hash<std::string_view>{}(_key(_keys[i]));
+                    keys.index.assign(std::bit_ceil(n * 4), 0);
+                    for (size_t i = 0; i < n; ++i)
+                        _index_key(keys, i);
+                }
+                return true;
+            }
+
+            void _index_key(object_keys& keys, const size_t i)noexcept {
+                const size_t mask = keys.index.size() - 1;
+                size_t slot = _keys[keys.begin + i].hash & mask;
+                while (keys.index[slot] != 0)
+                    slot = (slot + 1) & mask;
+                keys.index[slot] = static_cast<uint32_t>(i + 1);
+            }
+
+            std::optional<parse_error_t> _begin(const tape_t type)noexcept {
+                if (static_cast<int>(_open.size()) >= _max_depth)
+                    return parse_error_t::too_deep;
+                _open.push_back(_doc._tape.size());
+                _push(type, 0);
+                return {};
+            }
+
+            std::optional<parse_error_t> _end(const tape_t type)noexcept {
+                const size_t begin = _open.back();
+                _open.pop_back();
+                const size_t offset = _doc._tape.size() - begin;
+                _doc._tape[begin] |= offset;
+                _push(type, offset);
+                return {};
+            }
+
+            tape_document _doc;
+            // begin words of the open containers
+            std::vector<size_t> _open;
+            std::vector<key_t> _keys;
+            std::vector<object_keys> _objects;
+            int _max_depth;
+        };
+
+        // A tape_builder that records strings without escapes as borrowed_string words pointing into input.
+        struct view_builder : tape_builder {
+            view_builder(int depth, std::string_view input = {})noexcept :tape_builder{ depth }, _input{ input } {}
+
+            std::optional<parse_error_t> on_borrowed_key(std::string_view key)noexcept {
+                if (!_add_key(key))
+                    return parse_error_t::duplicate_key;
+                return on_borrowed_string(key);
+            }
+
+            std::optional<parse_error_t> on_borrowed_string(std::string_view str)noexcept {
+                assert(str.data() >= _input.data() and str.data() + str.size() <= _input.data() + _input.size());
+                _push(tape_t::borrowed_string, str.size());
+                _doc._tape.push_back(std::bit_cast<uint64_t>(str.data()));
+                return {};
+            }
+
+            view_document get()noexcept {
+                view_document res;
+                res._doc = tape_builder::get();
+                res._input = _input;
+                return res;
+            }
+
+            private:
+            std::string_view _input;
         };
 
         struct serializer {
@@ -2219,13 +5255,13 @@ namespace json {
             }
 
             std::optional<serialize_error_t> operator()(const json::value& v)noexcept {
-                return std::visit(*this, v.data);
+                return v.visit(*this);
             }
 
             std::optional<serialize_error_t> operator()(const json::array& arr)noexcept {
                 js += '[';
                 for (const auto& v : arr) {
-                    auto err = std::visit(*this, v.data);
+                    auto err = v.visit(*this);
                     if (err)
                         return err;
                     js += ',';
@@ -2239,11 +5275,11 @@ namespace json {
             std::optional<serialize_error_t> operator()(const json::object& obj)noexcept {
                 js += '{';
                 for (const auto& [k, v] : obj) {
-                    auto err = (*this)(k);
+                    auto err = (*this)(k.view());
                     if (err)
                         return err;
                     js += ':';
-                    err = std::visit(*this, v.data);
+                    err = v.visit(*this);
                     if (err)
                         return err;
                     js += ',';
@@ -2254,7 +5290,11 @@ namespace json {
                 return {};
             }
 
-            std::optional<serialize_error_t> operator()(const std::string& str)noexcept {
+            std::optional<serialize_error_t> operator()(const std::pmr::string& str)noexcept {
+                return (*this)(std::string_view{ str });
+            }
+
+            std::optional<serialize_error_t> operator()(std::string_view str)noexcept {
                 js += '\"';
                 for (auto i = 0; i < str.size(); ++i) {
                     const auto c = str[i];
@@ -2323,6 +5363,9 @@ namespace json {
             }
 
             std::optional<serialize_error_t> operator()(const double x)noexcept {
+                // JSON has no inf or nan, out of range numbers such as 1e400 are parsed as inf
+                if (!std::isfinite(x))
+                    return serialize_error_t::non_finite_number;
                 std::format_to(std::back_inserter(js), "{}", x);
                 return {};
             }
@@ -2338,6 +5381,104 @@ namespace json {
             private:
             std::string js;
         };
+
+        template<Builder B>
+        std::expected<decltype(std::declval<B>().get()), parse_error_t> parse_buffer(const char* data, size_t size, B& builder, fused_parser<B>& parser)noexcept {
+            auto err = parser(data, size);
+            if (err)
+                return std::unexpected(*err);
+            auto end = lexer<detail::parser<B>>::skip_space(parser.consumed(), data + size);
+            if (end != data + size)
+                return std::unexpected(parse_error_t::extra_content);
+            return builder.get();
+        }
+
+        template<Builder B>
+        void reset_builder(B& builder, const int depth)noexcept {
+            if constexpr (requires { builder.reset(); })
+                builder.reset();
+            else builder = B{ depth };
+        }
+
+        using file_ptr = std::unique_ptr<FILE, std::function<void(FILE*)>>;
+
+        inline file_ptr open_file(const std::string& path)noexcept {
+            std::FILE* file = nullptr;
+
+#ifdef _MSC_VER
+            if (fopen_s(&file, path.c_str(), "r"))
+                return nullptr;
+#else 
+            file = fopen(path.c_str(), "r");
+#endif // _MSC_VER
+
+            if (!file)
+                return nullptr;
+            return file_ptr{ file, [ ](FILE* f)noexcept { ::fclose(f); } };
+        }
+
+        template<Builder B>
+        std::expected<decltype(std::declval<B>().get()), parse_error_t> parse_file(const std::string& path, B& builder, lexer<parser<B>>& lexer, std::vector<char>& buffer)noexcept {
+            auto guard = open_file(path);
+            if (!guard)
+                return std::unexpected(parse_error_t::read_file_error);
+            std::FILE* const file = guard.get();
+
+            while (true) {
+                auto n = ::fread(buffer.data(), 1, buffer.size(), file);
+                if (n < buffer.size()) {
+                    if (::ferror(file))
+                        return std::unexpected(parse_error_t::read_file_error);
+                    // EOF
+                    if (n == 0) {
+                        return std::unexpected(parse_error_t::early_EOF);
+                    }
+                    auto err = lexer(buffer.data(), n);
+                    if (err) {
+                        if (*err != parse_error_t::happy_ending)
+                            return std::unexpected(*err);
+                        // finish
+                        auto end = lexer.skip_space(buffer.data() + lexer.bytes, buffer.data() + n);
+                        if (end != buffer.data() + n) // extra content
+                        {
+                            return std::unexpected(parse_error_t::extra_content);
+                        }
+                        return builder.get();
+                    }
+                    // early EOF
+                    return std::unexpected(parse_error_t::early_EOF);
+                }
+                // n == buffer.size()
+                auto err = lexer(buffer.data(), buffer.size());
+                if (err) {
+                    if (*err == parse_error_t::happy_ending) {
+                        auto end = lexer.skip_space(buffer.data() + lexer.bytes, buffer.data() + buffer.size());
+                        if (end != buffer.data() + buffer.size()) // extra content
+                            return std::unexpected(parse_error_t::extra_content);
+                        break;
+                    }
+                    return std::unexpected(*err);
+                }
+            }
+
+            // May be have extra content
+            while (true) {
+                auto n = ::fread(buffer.data(), 1, buffer.size(), file);
+                if (n == 0)
+                    return builder.get();
+                auto end = lexer.skip_space(buffer.data(), buffer.data() + n);
+                if (end != buffer.data() + n) // extra content
+                    return std::unexpected(parse_error_t::extra_content);
+                if (n < buffer.size()) {
+                    if (::ferror(file))
+                        return std::unexpected(parse_error_t::read_file_error);
+                    // EOF
+                    return builder.get();
+                }
+            }
+
+            std::unreachable();
+        }
     }
 
     constexpr std::expected<std::string, serialize_error_t> to_json(const auto& dom)noexcept {
@@ -2348,24 +5489,81 @@ namespace json {
         return serializer.get();
     }
 
+    // What for_each_document does with a record that fails to parse.
+    enum struct bad_record_t : uint8_t {
+        stop,   // return its error
+        skip    // drop the rest of its line and go on with the next one
+    };
+
     template<Builder B = detail::document_builder>
     constexpr std::expected<decltype(std::declval<B>().get()), parse_error_t> parse(const char* data, size_t size, int depth = 19)noexcept {
         B builder{ depth };
         detail::parser parser{ &builder };
-        detail::lexer lexer{ &parser };
+        detail::fused_parser fused{ &parser };
+        return detail::parse_buffer(data, size, builder, fused);
+    }
 
-        auto err = lexer(data, size);
-        if (err) {
-            if (*err != parse_error_t::happy_ending)
-                return std::unexpected(*err);
-            auto end = lexer.skip_space(data + lexer.bytes, data + size);
-            if (end != data + size)
-                return std::unexpected(parse_error_t::extra_content);
-            return builder.get();
-        }
-        return std::unexpected(parse_error_t::early_EOF);
+    // Same as parse with every string and container of the document allocated from mr, which has to
+    // outlive the document. Typically an arena such as std::pmr::monotonic_buffer_resource, see abandon.
+    // With symbols the long keys of all objects are interned there, the table has to outlive the document.
+    inline std::expected<json::document, parse_error_t> parse(const char* data, size_t size, std::pmr::memory_resource* mr, int depth = 19, symbol_table* symbols = nullptr)noexcept {
+        assert(mr);
+        detail::document_builder builder{ depth, mr, symbols };
+        detail::parser parser{ &builder };
+        detail::fused_parser fused{ &parser };
+        return detail::parse_buffer(data, size, builder, fused);
+    }
+
+    inline std::expected<json::document, parse_error_t> parse(const char* data, size_t size, symbol_table& symbols, int depth = 19)noexcept {
+        return parse(data, size, std::pmr::get_default_resource(), depth, &symbols);
+    }
+
+    // Two stage parsing of a complete buffer: a SIMD pass indexes the structural characters, then the
+    // index is walked to drive the builder. Same results and error codes as parse, but not faster: parse
+    // reads each token in a single pass, which the extra indexing pass does not pay for.
+    template<Builder B = detail::document_builder>
+    constexpr std::expected<decltype(std::declval<B>().get()), parse_error_t> parse_indexed(const char* data, size_t size, int depth = 19)noexcept {
+        if (size > std::numeric_limits<uint32_t>::max())
+            return parse<B>(data, size, depth);
+        std::vector<uint32_t> index;
+        detail::index_structurals(data, size, index);
+        B builder{ depth };
+        detail::indexed_parser parser{ &builder, data, size };
+
+        auto err = parser(index.data(), index.data() + index.size());
+        if (err)
+            return std::unexpected(*err);
+        if (parser.consumed() != index.data() + index.size())
+            return std::unexpected(parse_error_t::extra_content);
+        return builder.get();
+    }
+
+    // Parses into a tape_document, which copies its strings and does not depend on the input.
+    inline std::expected<tape_document, parse_error_t> parse_tape(const char* data, size_t size, int depth = 19)noexcept {
+        return parse<detail::tape_builder>(data, size, depth);
+    }
+
+    inline std::expected<tape_document, parse_error_t> parse_tape(std::string_view input, int depth = 19)noexcept {
+        return parse_tape(input.data(), input.size(), depth);
+    }
+
+    // Parses without copying strings: see view_document for how long the result may be used.
+    inline std::expected<view_document, parse_error_t> parse_view(const char* data, size_t size, int depth = 19)noexcept {
+        detail::view_builder builder{ depth, { data, size } };
+        detail::parser parser{ &builder };
+        detail::fused_parser fused{ &parser };
+        return detail::parse_buffer(data, size, builder, fused);
+    }
+
+    inline std::expected<view_document, parse_error_t> parse_view(std::string_view input, int depth = 19)noexcept {
+        return parse_view(input.data(), input.size(), depth);
     }
 
+    // The document would outlive a temporary string.
+    template<class S>
+        requires std::same_as<S, std::string>
+    std::expected<view_document, parse_error_t> parse_view(S&& input, int depth = 19) = delete;
+
     template<Builder B = detail::document_builder>
     constexpr std::expected<decltype(std::declval<B>().get()), parse_error_t> from_file(const std::string& path, size_t buf_size = 4096, int depth = 19)noexcept {
         assert(buf_size > 0);
@@ -2373,76 +5571,233 @@ namespace json {
         B builder{ depth };
         detail::parser parser{ &builder };
         detail::lexer lexer{ &parser };
+        std::vector<char> buffer(buf_size);
+        return detail::parse_file(path, builder, lexer, buffer);
+    }
 
+    inline std::expected<json::document, parse_error_t> from_file(const std::string& path, std::pmr::memory_resource* mr, size_t buf_size = 4096, int depth = 19, symbol_table* symbols = nullptr)noexcept {
+        assert(buf_size > 0);
+        assert(!path.empty());
+        assert(mr);
+        detail::document_builder builder{ depth, mr, symbols };
+        detail::parser parser{ &builder };
+        detail::lexer lexer{ &parser };
         std::vector<char> buffer(buf_size);
-        std::FILE* file = nullptr;
+        return detail::parse_file(path, builder, lexer, buffer);
+    }
 
-#ifdef _MSC_VER
-        if (fopen_s(&file, path.c_str(), "r"))
-            return std::unexpected(parse_error_t::read_file_error);
-#else 
-        file = fopen(path.c_str(), "r");
-#endif // _MSC_VER
+    inline std::expected<json::document, parse_error_t> from_file(const std::string& path, symbol_table& symbols, size_t buf_size = 4096, int depth = 19)noexcept {
+        return from_file(path, std::pmr::get_default_resource(), buf_size, depth, &symbols);
+    }
 
-        if (!file)
-            return std::unexpected(parse_error_t::read_file_error);
+    // Ends a document without running the destructors of its nodes. For a document that lives entirely
+    // in an arena it is all given back at once when the arena is released, instead of node by node.
+    // Anything in it allocated from another resource leaks.
+    inline void abandon(json::document&& doc)noexcept {
+        // the moved from document left behind is empty
+        alignas(json::document) std::byte storage[sizeof(json::document)];
+        std::construct_at(reinterpret_cast<json::document*>(storage), std::move(doc));
+    }
 
-        std::unique_ptr<FILE, std::function<void(FILE*)>> guard{ file, [ ](FILE* f)noexcept { ::fclose(f); } };
+    // Keeps the builder, the parser stacks and the file buffer between parses, so that parsing many
+    // documents in a row allocates them only once. One context per thread.
+    template<Builder B = detail::document_builder>
+    struct parse_context {
+        explicit parse_context(int depth = 19, size_t buf_size = 4096)
+            :_depth{ depth }, _builder{ depth }, _parser{ &_builder, 2 * static_cast<size_t>(std::max(depth, 0)) + 2 },
+            _fused{ &_parser }, _lexer{ &_parser }, _buffer(buf_size) {
+            assert(buf_size > 0);
+        }
 
-        while (true) {
-            auto n = ::fread(buffer.data(), 1, buffer.size(), file);
-            if (n < buffer.size()) {
-                if (::ferror(file))
-                    return std::unexpected(parse_error_t::read_file_error);
-                // EOF
-                if (n == 0) {
-                    return std::unexpected(parse_error_t::early_EOF);
+        parse_context(const parse_context&) = delete;
+        parse_context& operator=(const parse_context&) = delete;
+
+        std::expected<decltype(std::declval<B>().get()), parse_error_t> parse(const char* data, size_t size)noexcept {
+            _reset();
+            return detail::parse_buffer(data, size, _builder, _fused);
+        }
+
+        std::expected<decltype(std::declval<B>().get()), parse_error_t> from_file(const std::string& path)noexcept {
+            assert(!path.empty());
+            _reset();
+            return detail::parse_file(path, _builder, _lexer, _buffer);
+        }
+
+        // Passes every top-level value of the input to callback in order, see for_each_document.
+        template<std::invocable<decltype(std::declval<B>().get())> F>
+        std::optional<parse_error_t> for_each(const char* data, size_t size, F&& callback, bad_record_t policy = bad_record_t::stop) {
+            size_t begin = 0;
+            bool stopped = false;
+            _skip_line = false;
+            return _records(data, size, begin, true, callback, policy, stopped);
+        }
+
+        // Streams the file through the buffer, which only grows to hold a record longer than it.
+        template<std::invocable<decltype(std::declval<B>().get())> F>
+        std::optional<parse_error_t> for_each_from_file(const std::string& path, F&& callback, bad_record_t policy = bad_record_t::stop) {
+            assert(!path.empty());
+            auto file = detail::open_file(path);
+            if (!file)
+                return parse_error_t::read_file_error;
+            size_t begin = 0;
+            size_t filled = 0;
+            bool eof = false;
+            bool stopped = false;
+            _skip_line = false;
+            while (true) {
+                // keep the record cut by the end of the buffer
+                std::memmove(_buffer.data(), _buffer.data() + begin, filled - begin);
+                filled -= begin;
+                begin = 0;
+                if (filled == _buffer.size())
+                    _buffer.resize(2 * _buffer.size());
+                const auto n = ::fread(_buffer.data() + filled, 1, _buffer.size() - filled, file.get());
+                if (n < _buffer.size() - filled) {
+                    if (::ferror(file.get()))
+                        return parse_error_t::read_file_error;
+                    eof = true;
                 }
-                auto err = lexer(buffer.data(), n);
-                if (err) {
-                    if (*err != parse_error_t::happy_ending)
-                        return std::unexpected(*err);
-                    // finish
-                    auto end = lexer.skip_space(buffer.data() + lexer.bytes, buffer.data() + n);
-                    if (end != buffer.data() + n) // extra content
-                    {
-                        return std::unexpected(parse_error_t::extra_content);
+                filled += n;
+                auto err = _records(_buffer.data(), filled, begin, eof, callback, policy, stopped);
+                if (err or stopped or eof)
+                    return err;
+            }
+        }
+
+        private:
+        // Delivers the records of data from begin on. Unless last, a record cut by the end of data is left
+        // for later with begin on its first byte.
+        template<class F>
+        std::optional<parse_error_t> _records(const char* const data, const size_t size, size_t& begin, const bool last, F& callback, const bad_record_t policy, bool& stopped) {
+            const char* const end = data + size;
+            while (true) {
+                const char* p = data + begin;
+                if (_skip_line) {
+                    const auto* newline = static_cast<const char*>(std::memchr(p, '\n', end - p));
+                    if (newline == nullptr) {
+                        begin = size;
+                        return {};
                     }
-                    return builder.get();
+                    _skip_line = false;
+                    p = newline + 1;
                 }
-                // early EOF
-                return std::unexpected(parse_error_t::early_EOF);
-            }
-            // n == buffer.size()
-            auto err = lexer(buffer.data(), buffer.size());
-            if (err) {
-                if (*err == parse_error_t::happy_ending) {
-                    auto end = lexer.skip_space(buffer.data() + lexer.bytes, buffer.data() + buffer.size());
-                    if (end != buffer.data() + buffer.size()) // extra content
-                        return std::unexpected(parse_error_t::extra_content);
-                    break;
+                p = detail::lexer<detail::parser<B>>::skip_space(p, end);
+                begin = p - data;
+                if (p == end)
+                    return {};
+                _reset();
+                auto err = _fused(p, end - p);
+                if (!err) {
+                    begin = _fused.consumed() - data;
+                    if constexpr (std::same_as<std::invoke_result_t<F&, decltype(_builder.get())>, bool>) {
+                        if (!callback(_builder.get())) {
+                            stopped = true;
+                            return {};
+                        }
+                    }
+                    else callback(_builder.get());
+                    continue;
                 }
-                return std::unexpected(*err);
+                if (*err == parse_error_t::early_EOF and !last)
+                    return {};
+                if (policy == bad_record_t::stop)
+                    return err;
+                _skip_line = true;
+                ++begin;
             }
         }
 
-        // May be have extra content
-        while (true) {
-            auto n = ::fread(buffer.data(), 1, buffer.size(), file);
-            if (n == 0)
-                return builder.get();
-            auto end = lexer.skip_space(buffer.data(), buffer.data() + n);
-            if (end != buffer.data() + n) // extra content
-                return std::unexpected(parse_error_t::extra_content);
-            if (n < buffer.size()) {
-                if (::ferror(file))
-                    return std::unexpected(parse_error_t::read_file_error);
-                // EOF
-                return builder.get();
+        void _reset()noexcept {
+            detail::reset_builder(_builder, _depth);
+            _parser.reset();
+            _lexer.reset();
+        }
+
+        int _depth;
+        B _builder;
+        detail::parser<B> _parser;
+        detail::fused_parser<B> _fused;
+        detail::lexer<detail::parser<B>> _lexer;
+        std::vector<char> _buffer;
+        // resyncing after a bad record
+        bool _skip_line = false;
+    };
+
+    // Push parser for a document that arrives in pieces, e.g. a request body read from a socket: each piece
+    // is lexed as it is fed, only the string or number cut between two pieces is kept. Errors stick, once a
+    // piece fails every later call returns the same error. reset() starts the next document.
+    template<Builder B = detail::document_builder>
+    struct stream_parser {
+        explicit stream_parser(int depth = 19)
+            :_depth{ depth }, _builder{ depth }, _parser{ &_builder, 2 * static_cast<size_t>(std::max(depth, 0)) + 2 },
+            _lexer{ &_parser } {}
+
+        stream_parser(const stream_parser&) = delete;
+        stream_parser& operator=(const stream_parser&) = delete;
+
+        std::optional<parse_error_t> feed(const char* data, size_t size)noexcept {
+            if (_error)
+                return _error;
+            const char* rest = data;
+            if (!_done) {
+                auto err = _lexer(data, size);
+                if (!err)
+                    return {};
+                if (*err != parse_error_t::happy_ending) {
+                    _error = err;
+                    return _error;
+                }
+                _done = true;
+                rest += _lexer.bytes;
             }
+            // only spaces may follow the document
+            if (_lexer.skip_space(rest, data + size) != data + size)
+                _error = parse_error_t::extra_content;
+            return _error;
         }
 
-        std::unreachable();
+        std::expected<decltype(std::declval<B>().get()), parse_error_t> finish()noexcept {
+            if (_error)
+                return std::unexpected(*_error);
+            if (!_done)
+                return std::unexpected(parse_error_t::early_EOF);
+            return _builder.get();
+        }
+
+        // The document is complete, finish() would not fail on early_EOF.
+        bool done()const noexcept {
+            return _done;
+        }
+
+        void reset()noexcept {
+            detail::reset_builder(_builder, _depth);
+            _parser.reset();
+            _lexer.reset();
+            _done = false;
+            _error.reset();
+        }
+
+        private:
+        int _depth;
+        B _builder;
+        detail::parser<B> _parser;
+        detail::lexer<detail::parser<B>> _lexer;
+        bool _done = false;
+        std::optional<parse_error_t> _error;
+    };
+
+    // Parses a sequence of top-level values, such as NDJSON, with one parser reused for every record,
+    // and passes each document to callback. A callback returning bool stops the walk with false.
+    template<Builder B = detail::document_builder, std::invocable<decltype(std::declval<B>().get())> F>
+    std::optional<parse_error_t> for_each_document(const char* data, size_t size, F&& callback, bad_record_t policy = bad_record_t::stop, int depth = 19) {
+        parse_context<B> context{ depth, 1 };
+        return context.for_each(data, size, callback, policy);
+    }
+
+    template<Builder B = detail::document_builder, std::invocable<decltype(std::declval<B>().get())> F>
+    std::optional<parse_error_t> for_each_document(const std::string& path, F&& callback, bad_record_t policy = bad_record_t::stop, size_t buf_size = 1 << 16, int depth = 19) {
+        parse_context<B> context{ depth, buf_size };
+        return context.for_each_from_file(path, callback, policy);
     }
 
 }
\ No newline at end of file
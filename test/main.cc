@@ -4,6 +4,8 @@
 #include <fstream>
 #include <chrono>
 #include <filesystem>
+#include <thread>
+#include <random>
 
 #include "cJSON.h"
 
@@ -47,6 +49,639 @@ void parse_test() {
     }
 }
 
+void parse_indexed_test() {
+    auto dir = R"(./test/json/)";
+    for (auto& p : std::filesystem::directory_iterator(dir)) {
+        auto file_name = p.path().filename().string();
+        auto js = read_file(p.path().string());
+        auto expected = json::parse(js.data(), js.size());
+        auto ret = json::parse_indexed(js.data(), js.size());
+        bool ok = ret.has_value() == expected.has_value();
+        if (ok and ret.has_value())
+            ok = json::to_json(*ret) == json::to_json(*expected);
+        else if (ok)
+            ok = ret.error() == expected.error();
+        if (ok and file_name.starts_with("fail"))
+            ok = !ret.has_value();
+        if (ok)
+            std::cout << std::format("Test indexed {:24}: OK!\n", file_name);
+        else std::cout << std::format("Test indexed {:24}: FAILED!\n", file_name);
+    }
+
+    // malformed input reports the same error as parse
+    constexpr std::string_view malformed[] = {
+        "[90071f9254740993]", "[1,2.5,\"tab\t\",]", "{\"a\":\n,\"b\":1}", "{\"key\" nul}", "{\"key\" null}",
+        "t[-0]", "n", "[1,]", "[1 2]", "{\"a\":1,}", "[tru]", "[nul", "{:1}", "[\"a\" true]", "[1}", "[01]",
+        "[-]", "[\"\\x\"]", "[1]x", "{\"a\"]", "[\"a\":1]", "[]]"
+    };
+    for (size_t i = 0; i < std::size(malformed); ++i) {
+        const auto js = malformed[i];
+        auto expected = json::parse(js.data(), js.size());
+        auto ret = json::parse_indexed(js.data(), js.size());
+        const bool ok = !ret.has_value() and !expected.has_value() and ret.error() == expected.error();
+        if (ok)
+            std::cout << std::format("Test indexed {:24}: OK!\n", std::format("malformed {}", i));
+        else std::cout << std::format("Test indexed {:24}: FAILED!\n", std::format("malformed {}", i));
+    }
+}
+
+void complete_buffer_test() {
+    // parse reads the buffer whole, from_file resumes across small chunks: every prefix of every
+    // document has to give the same result through both
+    auto dir = R"(./test/json/)";
+    const auto tmp = (std::filesystem::temp_directory_path()
+        / std::format("json_complete_buffer_{}.json", std::chrono::steady_clock::now().time_since_epoch().count())).string();
+    for (auto& p : std::filesystem::directory_iterator(dir)) {
+        auto file_name = p.path().filename().string();
+        const auto js = read_file(p.path().string());
+        if (js.size() > 4096)
+            continue;
+        bool ok = true;
+        for (size_t n = 0; ok and n <= js.size(); ++n) {
+            std::ofstream{ tmp, std::ios::binary } << js.substr(0, n);
+            auto expected = json::from_file(tmp, 7);
+            auto ret = json::parse(js.data(), n);
+            ok = ret.has_value() == expected.has_value() and (ret.has_value() or ret.error() == expected.error());
+        }
+        if (ok)
+            std::cout << std::format("Test complete {:23}: OK!\n", file_name);
+        else std::cout << std::format("Test complete {:23}: FAILED!\n", file_name);
+    }
+    std::filesystem::remove(tmp);
+}
+
+void parse_context_test() {
+    auto dir = R"(./test/json/)";
+    json::parse_context context{ 19, 4096 * 4 };
+    for (auto& p : std::filesystem::directory_iterator(dir)) {
+        auto file_name = p.path().filename().string();
+        auto js = read_file(p.path().string());
+        auto expected = json::parse(js.data(), js.size());
+        auto ret = context.parse(js.data(), js.size());
+        auto file = context.from_file(p.path().string());
+        bool ok = ret.has_value() == expected.has_value() and file.has_value() == expected.has_value();
+        if (ok and ret.has_value())
+            ok = json::to_json(*ret) == json::to_json(*expected) and json::to_json(*file) == json::to_json(*expected);
+        if (ok)
+            std::cout << std::format("Test context {:24}: OK!\n", file_name);
+        else std::cout << std::format("Test context {:24}: FAILED!\n", file_name);
+    }
+}
+
+// Checks that borrowed strings point into the input, then builds the document as usual.
+struct borrow_checker : json::detail::document_builder {
+    using document_builder::document_builder;
+
+    std::optional<json::parse_error_t> on_borrowed_key(std::string_view str)noexcept {
+        check(str);
+        return on_key(str);
+    }
+
+    std::optional<json::parse_error_t> on_borrowed_string(std::string_view str)noexcept {
+        check(str);
+        return on_string(str);
+    }
+
+    void check(std::string_view str)noexcept {
+        ++borrowed;
+        inside = inside and str.data() >= input.data() and str.data() + str.size() <= input.data() + input.size();
+    }
+
+    static inline std::string_view input;
+    static inline size_t borrowed = 0;
+    static inline bool inside = true;
+};
+
+void borrowed_string_test() {
+    static_assert(json::BorrowingBuilder<borrow_checker>);
+    static_assert(!json::BorrowingBuilder<json::detail::document_builder>);
+    constexpr std::string_view js = R"({"a":"b\n","c":["d", "\u00e9"], "e\t":"f"})";
+    borrow_checker::input = js;
+    auto expected = json::to_json(*json::parse(js.data(), js.size()));
+    for (bool indexed : { false, true }) {
+        borrow_checker::borrowed = 0;
+        auto ret = indexed ? json::parse_indexed<borrow_checker>(js.data(), js.size()) : json::parse<borrow_checker>(js.data(), js.size());
+        bool ok = ret.has_value() and json::to_json(*ret) == expected and borrow_checker::borrowed == 4 and borrow_checker::inside;
+        auto name = indexed ? "parse_indexed" : "parse";
+        if (ok)
+            std::cout << std::format("Test borrowed {:23}: OK!\n", name);
+        else std::cout << std::format("Test borrowed {:23}: FAILED!\n", name);
+    }
+}
+
+// Drops keys starting with '_' and, when asked, every array but the outermost one.
+struct skipping_builder : json::detail::document_builder {
+    using document_builder::document_builder;
+
+    std::optional<json::parse_error_t> on_key(std::string_view key)noexcept {
+        if (key.starts_with('_'))
+            return json::parse_error_t::skip;
+        return document_builder::on_key(key);
+    }
+
+    std::optional<json::parse_error_t> on_array_begin()noexcept {
+        if (skip_arrays and _arrays++ > 0)
+            return json::parse_error_t::skip;
+        return document_builder::on_array_begin();
+    }
+
+    static inline bool skip_arrays = false;
+    int _arrays = 0;
+};
+
+void skip_test() {
+    constexpr std::pair<std::string_view, std::string_view> cases[] = {
+        { R"({"a":1,"_b":{"x":[1,{"y":"}]"}],"z":"\"{"},"c":[true,[2,3]],"_d":"s\"]","e":null,"_f":-1.5e3 ,"g":{"_h":[[[]]]}})",
+          R"({"a":1,"c":[true,[2,3]],"e":null,"g":{}})" },
+        { R"([1,[2,[3,"]["]],"x",[ ],4])", R"([1,"x",4])" },
+        // dropped values are not read, malformed content in them is no error
+        { R"({"a":1,"_b":["\{",1e,tru],"c":2,"_d":"\x"})", R"({"a":1,"c":2})" },
+    };
+    const auto path = (std::filesystem::temp_directory_path() / "json_skip_test.json").string();
+    for (size_t i = 0; i < std::size(cases); ++i) {
+        auto [js, expected] = cases[i];
+        skipping_builder::skip_arrays = i == 1;
+        std::ofstream(path, std::ios::binary) << js;
+        auto want = json::to_json(*json::parse(expected.data(), expected.size()));
+        auto a = json::parse<skipping_builder>(js.data(), js.size());
+        auto b = json::parse_indexed<skipping_builder>(js.data(), js.size());
+        auto c = json::from_file<skipping_builder>(path, 3);
+        bool ok = a and b and c and json::to_json(*a) == want and json::to_json(*b) == want and json::to_json(*c) == want;
+        if (ok)
+            std::cout << std::format("Test skip {:27}: OK!\n", i);
+        else std::cout << std::format("Test skip {:27}: FAILED!\n", i);
+    }
+    // a dropped value ends where parse_indexed starts the next token, what follows must still fit the grammar
+    constexpr std::string_view rejected[] = {
+        R"({"_a":1:2})", R"({"_a":1"x"})", R"({"_a":1{}})", R"({"_a":tru[1]})", R"({"_a":1 2})",
+        R"({"_a":"s":1})", R"({"_a":[]:1})", R"({"_a":{}"x"})", R"({"_a":1)",
+    };
+    skipping_builder::skip_arrays = false;
+    for (auto js : rejected) {
+        std::ofstream(path, std::ios::binary) << js;
+        auto a = json::parse<skipping_builder>(js.data(), js.size());
+        auto b = json::parse_indexed<skipping_builder>(js.data(), js.size());
+        bool ok = !a and !b and a.error() == b.error();
+        for (size_t n = 1; ok and n <= js.size(); ++n) {
+            auto c = json::from_file<skipping_builder>(path, n);
+            ok = !c and c.error() == a.error();
+        }
+        if (ok)
+            std::cout << std::format("Test skip {:27}: OK!\n", js);
+        else std::cout << std::format("Test skip {:27}: FAILED!\n", js);
+    }
+    std::filesystem::remove(path);
+}
+
+void for_each_document_test() {
+    constexpr std::string_view ndjson =
+        "{\"id\":1,\"tags\":[\"a\",\"b\"]}\n"
+        "{\"id\":2,\"bad\":tru}\n"
+        "[1,2,\n3]\n"
+        "{\"id\":4,\"cut\":\n"
+        "{\"id\":5,\"s\":\"line\\nbreak\"}\n"
+        "\n"
+        "{\"id\":6}";
+    const std::string expected = R"({"id":1,"tags":["a","b"]}[1,2,3]{"id":5,"s":"line\nbreak"}{"id":6})";
+    const auto path = (std::filesystem::temp_directory_path() / "json_records_test.json").string();
+    std::ofstream(path, std::ios::binary) << ndjson;
+
+    std::string all;
+    auto collect = [&](json::document&& doc) { all += *json::to_json(doc); };
+    auto stop = json::for_each_document(ndjson.data(), ndjson.size(), collect);
+    bool ok = stop == json::parse_error_t::unknown_boolean_character and all == R"({"id":1,"tags":["a","b"]})";
+    for (size_t buf_size : { size_t(1) << 16, size_t(7) }) {
+        all.clear();
+        ok = ok and !json::for_each_document(ndjson.data(), ndjson.size(), collect, json::bad_record_t::skip) and all == expected;
+        all.clear();
+        ok = ok and !json::for_each_document(path, collect, json::bad_record_t::skip, buf_size) and all == expected;
+    }
+    int n = 0;
+    ok = ok and !json::for_each_document(path, [&](json::document&&) { return ++n < 2; }, json::bad_record_t::skip) and n == 2;
+    std::filesystem::remove(path);
+    if (ok)
+        std::cout << std::format("Test {:32}: OK!\n", "for_each_document");
+    else std::cout << std::format("Test {:32}: FAILED!\n", "for_each_document");
+}
+
+void stream_parser_test() {
+    auto dir = R"(./test/json/)";
+    json::stream_parser parser{ 19 };
+    std::mt19937 rng{ 42 };
+    for (auto& p : std::filesystem::directory_iterator(dir)) {
+        auto file_name = p.path().filename().string();
+        auto js = read_file(p.path().string());
+        auto expected = json::parse(js.data(), js.size());
+        parser.reset();
+        for (size_t i = 0; i < js.size();) {
+            size_t n = std::min<size_t>(rng() % 1500 + 1, js.size() - i);
+            parser.feed(js.data() + i, n);
+            i += n;
+        }
+        auto ret = parser.finish();
+        bool ok = ret.has_value() == expected.has_value();
+        if (ok and ret.has_value())
+            ok = json::to_json(*ret) == json::to_json(*expected);
+        else if (ok)
+            ok = ret.error() == expected.error();
+        if (ok)
+            std::cout << std::format("Test stream {:25}: OK!\n", file_name);
+        else std::cout << std::format("Test stream {:25}: FAILED!\n", file_name);
+    }
+}
+
+// Objects with repeated keys, some only in different objects, that are fine.
+constexpr std::string_view duplicate_keys[] = {
+    R"({"a":1,"a":2})", R"({"a":1,"b":2,"a":x})", R"({"a":{"a":1},"b":{"a":2}})", R"([{"k":1},{"k":2}])",
+    R"({"a":[{"b":1}],"b":{"b":1,"c":2,"b":3}})", R"({"\u0061":1,"a":2})",
+    R"({"k0":0,"k1":1,"k2":2,"k3":3,"k4":4,"k5":5,"k6":6,"k7":7,"k8":8,"k9":9,"k10":10,"k11":11,"k12":12,)"
+    R"("k13":13,"k14":14,"k15":15,"k16":16,"k17":17,"k18":18,"k19":19,"k20":20,"k7":7})",
+    R"({"k0":0,"k1":1,"k2":2,"k3":3,"k4":4,"k5":5,"k6":6,"k7":7,"k8":8,"k9":9,"k10":10,"k11":11,"k12":12,)"
+    R"("k13":13,"k14":14,"k15":15,"k16":16,"k17":17,"k18":18,"k19":19,"k20":20,"k21":{"k0":0}})",
+};
+
+void tape_document_test() {
+    auto dir = R"(./test/json/)";
+    for (auto& p : std::filesystem::directory_iterator(dir)) {
+        auto file_name = p.path().filename().string();
+        auto js = read_file(p.path().string());
+        auto expected = json::parse(js.data(), js.size());
+        auto ret = json::parse_tape(js.data(), js.size());
+        bool ok = ret.has_value() == expected.has_value();
+        if (ok and expected.has_value())
+            ok = json::to_json(ret->to_document()) == json::to_json(*expected);
+        else if (ok)
+            ok = ret.error() == expected.error();
+        if (ok)
+            std::cout << std::format("Test tape {:27}: OK!\n", file_name);
+        else std::cout << std::format("Test tape {:27}: FAILED!\n", file_name);
+    }
+
+    for (size_t i = 0; i < std::size(duplicate_keys); ++i) {
+        const auto js = duplicate_keys[i];
+        auto expected = json::parse(js.data(), js.size());
+        auto ret = json::parse_tape(js.data(), js.size());
+        bool ok = ret.has_value() == expected.has_value();
+        if (ok and expected.has_value())
+            ok = json::to_json(ret->to_document()) == json::to_json(*expected);
+        else if (ok)
+            ok = ret.error() == expected.error();
+        if (ok)
+            std::cout << std::format("Test tape {:27}: OK!\n", std::format("duplicate keys {}", i));
+        else std::cout << std::format("Test tape {:27}: FAILED!\n", std::format("duplicate keys {}", i));
+    }
+
+    constexpr std::string_view js = R"({"a":[1,"x",{"b":null},[]],"c":true,"d":"\u00e9"})";
+    auto doc = json::parse_tape(js);
+    bool ok = doc.has_value();
+    if (ok) {
+        auto root = doc->root();
+        auto a = root.find("a");
+        ok = root.is_object() and root.size() == 3 and a and a->is_array() and a->size() == 4
+            and (*a)[0].get_number() == 1 and (*a)[1].get_string() == "x" and (*a)[2].find("b")->is_null()
+            and (*a)[3].size() == 0 and root.find("c")->get_bool() and root.find("d")->get_string() == "\u00e9"
+            and !root.find("e");
+    }
+    if (ok)
+        std::cout << std::format("Test tape {:27}: OK!\n", "navigation");
+    else std::cout << std::format("Test tape {:27}: FAILED!\n", "navigation");
+}
+
+void parse_view_test() {
+    auto dir = R"(./test/json/)";
+    for (auto& p : std::filesystem::directory_iterator(dir)) {
+        auto file_name = p.path().filename().string();
+        auto js = read_file(p.path().string());
+        auto expected = json::parse(js.data(), js.size());
+        auto ret = json::parse_view(js);
+        bool ok = ret.has_value() == expected.has_value();
+        if (ok and expected.has_value())
+            ok = json::to_json(ret->to_document()) == json::to_json(*expected);
+        else if (ok)
+            ok = ret.error() == expected.error();
+        if (ok)
+            std::cout << std::format("Test view {:27}: OK!\n", file_name);
+        else std::cout << std::format("Test view {:27}: FAILED!\n", file_name);
+    }
+
+    for (size_t i = 0; i < std::size(duplicate_keys); ++i) {
+        const auto js = duplicate_keys[i];
+        auto expected = json::parse(js.data(), js.size());
+        auto ret = json::parse_view(js);
+        bool ok = ret.has_value() == expected.has_value();
+        if (ok and expected.has_value())
+            ok = json::to_json(ret->to_document()) == json::to_json(*expected);
+        else if (ok)
+            ok = ret.error() == expected.error();
+        if (ok)
+            std::cout << std::format("Test view {:27}: OK!\n", std::format("duplicate keys {}", i));
+        else std::cout << std::format("Test view {:27}: FAILED!\n", std::format("duplicate keys {}", i));
+    }
+
+    constexpr std::string_view js = R"({"a":"plain","b":"esc\"aped","k\u0065y":[1,"x"]})";
+    auto doc = json::parse_view(js);
+    auto inside = [&](std::string_view str) {
+        return str.data() >= js.data() and str.data() + str.size() <= js.data() + js.size();
+    };
+    bool ok = doc.has_value() and doc->input().data() == js.data();
+    if (ok) {
+        auto root = doc->root();
+        auto a = root.find("a"), b = root.find("b"), key = root.find("key");
+        ok = a and b and key and a->get_string() == "plain" and inside(a->get_string())
+            and b->get_string() == "esc\"aped" and !inside(b->get_string())
+            and key->size() == 2 and (*key)[0].get_number() == 1 and inside((*key)[1].get_string());
+    }
+    if (ok)
+        std::cout << std::format("Test view {:27}: OK!\n", "borrowed");
+    else std::cout << std::format("Test view {:27}: FAILED!\n", "borrowed");
+}
+
+void value_test() {
+    json::value val = json::object{
+        {"a", json::array{ 1., "x", json::null, true }},
+        {"b", json::object{ {"c", "long enough to live on the heap"} }}
+    };
+    auto copy = val;
+    auto moved = std::move(copy);
+    copy = moved;
+    copy["a"][0] = 2.;
+    copy["b"]["c"].get_string() += "!";
+    size_t count = 0;
+    for (const auto& v : val["a"].get_array())
+        count += v.visit([](const auto& x) { return sizeof(x) > 0; });
+    bool threw = false;
+    try {
+        (void)val["a"][1].get_number();
+    }
+    catch (const std::bad_variant_access&) {
+        threw = true;
+    }
+    const bool ok = sizeof(json::value) == 16 and moved == val and !(copy == val)
+        and val["a"][0].get_number() == 1. and copy["a"][0].get_number() == 2.
+        and val["b"]["c"].get_string().back() == 'p' and copy["b"]["c"].get_string().back() == '!'
+        and val["a"][2].is_null() and val["a"][3].type() == "boolean" and count == 4 and threw;
+    if (ok)
+        std::cout << std::format("Test value {:26}: OK!\n", "copy/move/visit");
+    else std::cout << std::format("Test value {:26}: FAILED!\n", "copy/move/visit");
+}
+
+void object_test() {
+    constexpr std::string_view js = R"({"z":1,"a":[true],"m":{"y":null,"b":"s"}})";
+    auto ret = json::parse(js.data(), js.size());
+    bool ok = ret.has_value() and json::to_json(*ret) == js;
+    if (ok)
+        std::cout << std::format("Test object {:25}: OK!\n", "insertion order");
+    else std::cout << std::format("Test object {:25}: FAILED!\n", "insertion order");
+
+    std::string big = "{";
+    for (int i = 0; i < 100; ++i)
+        big += std::format("\"k{}\":{},", i, i);
+    big.back() = '}';
+    ret = json::parse(big.data(), big.size());
+    ok = ret.has_value();
+    if (ok) {
+        auto& obj = std::get<json::object>(*ret);
+        for (int i = 0; i < 100; ++i)
+            ok = ok and obj.at(std::format("k{}", i)).get_number() == i;
+        ok = ok and obj.erase("k7") == 1 and obj.erase("k7") == 0 and !obj.contains("k7") and obj.size() == 99
+            and obj.find("k99")->second.get_number() == 99 and obj.begin()->first == "k0";
+        obj["k7"] = 7.;
+        ok = ok and (obj.end() - 1)->first == "k7" and obj.try_emplace("k7", 8.).second == false;
+    }
+    big.insert(big.size() - 1, ",\"k42\":0");
+    ok = ok and json::parse(big.data(), big.size()).error() == json::parse_error_t::duplicate_key;
+    if (ok)
+        std::cout << std::format("Test object {:25}: OK!\n", "hash index");
+    else std::cout << std::format("Test object {:25}: FAILED!\n", "hash index");
+}
+
+struct counting_resource : std::pmr::memory_resource {
+    size_t allocations = 0;
+
+    private:
+    void* do_allocate(size_t bytes, size_t alignment)override {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment)override {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other)const noexcept override {
+        return this == &other;
+    }
+};
+
+void arena_test() {
+    auto dir = R"(./test/json/)";
+    counting_resource heap;
+    auto old = std::pmr::set_default_resource(&heap);
+    for (auto& p : std::filesystem::directory_iterator(dir)) {
+        auto file_name = p.path().filename().string();
+        auto js = read_file(p.path().string());
+        auto expected = json::parse(js.data(), js.size());
+        std::pmr::monotonic_buffer_resource arena{ std::pmr::new_delete_resource() };
+        heap.allocations = 0;
+        auto ret = json::parse(js.data(), js.size(), &arena);
+        auto file = json::from_file(p.path().string(), &arena, 64);
+        bool ok = heap.allocations == 0 and ret.has_value() == expected.has_value() and file.has_value() == expected.has_value();
+        if (ok and expected.has_value()) {
+            ok = json::to_json(*ret) == json::to_json(*expected) and json::to_json(*file) == json::to_json(*expected);
+            json::abandon(std::move(*ret));
+            json::abandon(std::move(*file));
+        }
+        if (ok)
+            std::cout << std::format("Test arena {:26}: OK!\n", file_name);
+        else std::cout << std::format("Test arena {:26}: FAILED!\n", file_name);
+    }
+
+    std::pmr::monotonic_buffer_resource arena{ std::pmr::new_delete_resource() };
+    constexpr std::string_view js = R"([{"k":"a string long enough to allocate"},[1,2]])";
+    auto ret = json::parse(js.data(), js.size(), &arena);
+    heap.allocations = 0;
+    json::value copy = std::get<json::array>(*ret)[0];
+    bool ok = heap.allocations > 0 and copy.get_object().get_allocator().resource() == &heap
+        and copy == std::get<json::array>(*ret)[0];
+    std::pmr::set_default_resource(old);
+    if (ok)
+        std::cout << std::format("Test arena {:26}: OK!\n", "copy out of arena");
+    else std::cout << std::format("Test arena {:26}: FAILED!\n", "copy out of arena");
+}
+
+// distinct long keys and the distinct addresses they are stored at
+struct long_keys {
+    std::unordered_set<std::string_view> keys;
+    std::unordered_set<const char*> addresses;
+};
+
+void collect_long_keys(const auto& x, long_keys& seen) {
+    using T = std::remove_cvref_t<decltype(x)>;
+    if constexpr (std::same_as<T, json::array>)
+        for (auto& v : x)
+            collect_long_keys(v, seen);
+    else if constexpr (std::same_as<T, json::object>)
+        for (auto& [k, v] : x) {
+            if (!k.is_inline()) {
+                seen.keys.insert(k.view());
+                seen.addresses.insert(k.data());
+            }
+            collect_long_keys(v, seen);
+        }
+    else if constexpr (std::same_as<T, json::value>)
+        x.visit([&](const auto& y) { collect_long_keys(y, seen); });
+}
+
+void symbol_table_test() {
+    json::symbol_table symbols;
+    for (auto name : { "members.json", "github-events.json", "unconfirmed-transactions.json" }) {
+        auto js = read_file(std::string("./test/json/") + name);
+        auto expected = json::parse(js.data(), js.size());
+        std::expected<json::document, json::parse_error_t> ret[2];
+        {
+            std::jthread t0{ [&] { ret[0] = json::parse(js.data(), js.size(), symbols); } };
+            std::jthread t1{ [&] { ret[1] = json::parse(js.data(), js.size(), symbols); } };
+        }
+        bool ok = expected.has_value() and ret[0].has_value() and ret[1].has_value()
+            and json::to_json(*ret[0]) == json::to_json(*expected) and json::to_json(*ret[1]) == json::to_json(*expected);
+        if (ok) {
+            // the same long key is stored once for both documents
+            long_keys seen;
+            for (auto& doc : ret)
+                std::visit([&](const auto& x) { collect_long_keys(x, seen); }, *doc);
+            ok = !seen.keys.empty() and seen.keys.size() == seen.addresses.size() and seen.keys.size() <= symbols.size();
+        }
+        if (ok)
+            std::cout << std::format("Test symbols {:30}: OK!\n", name);
+        else std::cout << std::format("Test symbols {:30}: FAILED!\n", name);
+    }
+
+    constexpr std::string_view js = R"([{"a_key_longer_than_fifteen":1,"short":2},{"a_key_longer_than_fifteen":3,"short":4}])";
+    auto ret = json::parse(js.data(), js.size(), symbols);
+    bool ok = ret.has_value();
+    if (ok) {
+        auto& arr = std::get<json::array>(*ret);
+        auto& a = arr[0].get_object();
+        auto& b = arr[1].get_object();
+        json::object copy = a;
+        ok = a.begin()->first.data() == b.begin()->first.data() and b.find(a.begin()->first)->second.get_number() == 3
+            and a.symbols() == &symbols and copy.symbols() == nullptr and copy.begin()->first.data() != a.begin()->first.data()
+            and copy == a and copy.erase("a_key_longer_than_fifteen") == 1 and copy.size() == 1 and a.size() == 2;
+    }
+    if (ok)
+        std::cout << std::format("Test symbols {:30}: OK!\n", "shared keys");
+    else std::cout << std::format("Test symbols {:30}: FAILED!\n", "shared keys");
+}
+
+void parallel_escape_test() {
+    constexpr std::string_view escapes[] = {
+        R"(["\u00e9\u00e8", "\u4e2d\u6587", "\ud83d\ude00", "\u0041\u0042"])",
+        R"(["\u03b1\u03b2", "\ud834\udd1e", "\u65e5\u672c", "\u007a\u007e"])",
+        R"(["\u20ac\u00a3", "\uffe5\u00a5", "\ud83c\udf0d", "\u0030\u0039"])",
+        R"(["\u0416\u0436", "\u3042\u3044", "\ud800\udc00", "\u005c\u0022"])",
+    };
+    bool ok[std::size(escapes)]{};
+    {
+        std::vector<std::jthread> threads;
+        for (size_t i = 0; i < std::size(escapes); ++i) {
+            threads.emplace_back([&, i] {
+                const auto js = escapes[i];
+                const auto expected = json::to_json(*json::parse(js.data(), js.size()));
+                ok[i] = true;
+                for (int n = 0; n < 20000 and ok[i]; ++n) {
+                    auto ret = json::parse(js.data(), js.size());
+                    ok[i] = ret.has_value() and json::to_json(*ret) == expected;
+                }
+                });
+        }
+    }
+    for (size_t i = 0; i < std::size(escapes); ++i) {
+        if (ok[i])
+            std::cout << std::format("Test parallel escape {:16}: OK!\n", i);
+        else std::cout << std::format("Test parallel escape {:16}: FAILED!\n", i);
+    }
+}
+
+void utf8_test() {
+    // every engine, from_file split at every offset of the input
+    const auto tmp = (std::filesystem::temp_directory_path()
+        / std::format("json_utf8_{}.json", std::chrono::steady_clock::now().time_since_epoch().count())).string();
+    auto same_everywhere = [&](std::string_view js, auto&& check) {
+        bool ok = check(json::parse(js.data(), js.size())) and check(json::parse_indexed(js.data(), js.size()));
+        std::ofstream{ tmp, std::ios::binary } << js;
+        for (size_t n = 1; ok and n <= js.size(); ++n)
+            ok = check(json::from_file(tmp, n));
+        return ok;
+        };
+    constexpr std::pair<std::string_view, std::string_view> valid[] = {
+        { "[\"a\xC3\xA9\xE4\xB8\xAD\xF0\x9F\x98\x80" "b\"]", "a\xC3\xA9\xE4\xB8\xAD\xF0\x9F\x98\x80" "b" },
+        { "[\"\xEF\xBF\xBF\xF4\x8F\xBF\xBF\xED\x9F\xBF\"]", "\xEF\xBF\xBF\xF4\x8F\xBF\xBF\xED\x9F\xBF" },
+        { R"(["\ud83d\ude00\u00e9"])", "\xF0\x9F\x98\x80\xC3\xA9" },
+    };
+    for (auto [js, expected] : valid) {
+        const bool ok = same_everywhere(js, [&](const auto& ret) {
+            if (!ret.has_value() or std::get<json::array>(*ret)[0].get_string() != expected)
+                return false;
+            auto again = json::to_json(*ret);
+            return again.has_value() and json::parse(again->data(), again->size()).has_value();
+            });
+        if (ok)
+            std::cout << std::format("Test utf8 {:27}: OK!\n", std::format("valid {}", expected.size()));
+        else std::cout << std::format("Test utf8 {:27}: FAILED!\n", std::format("valid {}", expected.size()));
+    }
+    constexpr std::pair<std::string_view, std::string_view> invalid[] = {
+        { "overlong C0 80", "[\"a\xC0\x80\"]" },
+        { "overlong E0 80 80", "[\"a\xE0\x80\x80\"]" },
+        { "surrogate ED A0 80", "[\"a\xED\xA0\x80\"]" },
+        { "above 10FFFF F4 90 80 80", "[\"a\xF4\x90\x80\x80\"]" },
+        { "F5", "[\"a\xF5\x80\x80\x80\"]" },
+        { "lone continuation", "[\"a\x80\"]" },
+        { "truncated E4 B8", "[\"a\xE4\xB8\"]" },
+        { "lone low \\udc00", R"(["\udc00"])" },
+        { "lone high \\ud800", R"(["\ud800x"])" },
+        { "high high \\ud800\\ud800", R"(["\ud800\ud800"])" },
+        { "high BMP \\ud800\\u0041", R"(["\ud800\u0041"])" },
+    };
+    for (auto [name, js] : invalid) {
+        const auto error = js.contains('\\') ? json::parse_error_t::unknown_hex_character : json::parse_error_t::unknown_utf8_bytes;
+        const bool ok = same_everywhere(js, [&](const auto& ret) {
+            return !ret.has_value() and ret.error() == error;
+            });
+        if (ok)
+            std::cout << std::format("Test utf8 {:27}: OK!\n", name);
+        else std::cout << std::format("Test utf8 {:27}: FAILED!\n", name);
+    }
+    std::filesystem::remove(tmp);
+}
+
+void number_test() {
+    constexpr const char* numbers[] = {
+        "0", "-0", "12345", "-9007199254740993", "0.1", "3.141592653589793", "1e23", "-2.5E-3",
+        "2.2250738585072011e-308", "4.9406564584124654e-324", "1.7976931348623157e308", "1e400", "-1e-400",
+        "123456789012345678901234567890e-10", "0.00000000000000000000000000000000000000000000001",
+        "9007199254740992.50000000000000000001", "7.2057594037927933e16", "8.98846567431158e307"
+    };
+    for (auto num : numbers) {
+        const auto js = std::format("[{}]", num);
+        auto ret = json::parse(js.data(), js.size());
+        const bool ok = ret.has_value()
+            and std::get<json::array>(*ret)[0].get_number() == std::strtod(num, nullptr);
+        if (ok)
+            std::cout << std::format("Test number {:40}: OK!\n", num);
+        else std::cout << std::format("Test number {:40}: FAILED!\n", num);
+    }
+
+    // numbers out of double range parse as inf, which JSON cannot represent
+    for (auto num : { "[1e400]", "[-1e400]" }) {
+        auto ret = json::parse(num, std::strlen(num));
+        auto js = ret.has_value() ? json::to_json(*ret) : std::unexpected(json::serialize_error_t::error);
+        const bool ok = !js.has_value() and js.error() == json::serialize_error_t::non_finite_number;
+        if (ok)
+            std::cout << std::format("Test number {:40}: OK!\n", std::format("round trip {}", num));
+        else std::cout << std::format("Test number {:40}: FAILED!\n", std::format("round trip {}", num));
+    }
+}
+
 void from_file_test() {
     auto dir = R"(./test/json/)";
 
@@ -162,6 +797,78 @@ void benchmark_parse() {
     std::cout << std::format("{} MB/s\n\n", (js.size() >> 20) / per_parsing);
 }
 
+void benchmark_parse_indexed() {
+    std::cout << "Benchmark parse_indexed...\n";
+
+    auto path = R"(./test/json/big.json)";
+    const auto js = read_file(path);
+    std::cout << js.size() << '\n';
+
+    const int n = 100;
+
+    auto size = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i) {
+        auto dom = json::parse_indexed(js.data(), js.size(), 100);
+        if (dom and std::holds_alternative<json::array>(*dom))
+            size += std::get<json::array>(*dom).size();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout << std::format("result:{}\n", size);
+
+    double per_parsing = std::chrono::duration<double>(end - start).count() / n;
+    std::cout << std::format("{} MB/s\n\n", (js.size() >> 20) / per_parsing);
+}
+
+void benchmark_parse_tape() {
+    std::cout << "Benchmark parse tape_document...\n";
+
+    auto path = R"(./test/json/big.json)";
+    const auto js = read_file(path);
+    std::cout << js.size() << '\n';
+
+    const int n = 100;
+
+    auto size = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i) {
+        auto dom = json::parse_tape(js.data(), js.size(), 100);
+        if (dom and dom->root().is_array())
+            size += dom->root().size();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout << std::format("result:{}\n", size);
+
+    double per_parsing = std::chrono::duration<double>(end - start).count() / n;
+    std::cout << std::format("{} MB/s\n\n", (js.size() >> 20) / per_parsing);
+}
+
+void benchmark_parse_view() {
+    std::cout << "Benchmark parse_view...\n";
+
+    auto path = R"(./test/json/big.json)";
+    const auto js = read_file(path);
+    std::cout << js.size() << '\n';
+
+    const int n = 100;
+
+    auto size = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i) {
+        auto dom = json::parse_view(js, 100);
+        if (dom and dom->root().is_array())
+            size += dom->root().size();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout << std::format("result:{}\n", size);
+
+    double per_parsing = std::chrono::duration<double>(end - start).count() / n;
+    std::cout << std::format("{} MB/s\n\n", (js.size() >> 20) / per_parsing);
+}
+
 void benchmark_cJSON_parse() {
     std::cout << "Benchmark cJSON parse...\n";
 
@@ -214,11 +921,30 @@ void benchmark_pure_parse() {
 
 int main() {
     parse_test();
+    parse_indexed_test();
+    complete_buffer_test();
+    parse_context_test();
+    borrowed_string_test();
+    skip_test();
+    for_each_document_test();
+    stream_parser_test();
+    tape_document_test();
+    parse_view_test();
+    value_test();
+    object_test();
+    arena_test();
+    symbol_table_test();
+    parallel_escape_test();
+    utf8_test();
+    number_test();
     from_file_test();
     //single_file_test();
     make_big_file();
     benchmark_from_file();
     benchmark_parse();
+    benchmark_parse_indexed();
+    benchmark_parse_tape();
+    benchmark_parse_view();
     benchmark_cJSON_parse();
     benchmark_pure_parse();
     return 0;